@@ -100,7 +100,7 @@ void UnitAI::SelectTargetList(std::list<Unit*>& p_TargetList, uint32 p_Num, Sele
 
 Player* UnitAI::SelectRangedTarget(bool p_AllowHeal /*= true*/, int32 p_CheckAura /*= 0*/) const
 {
-    std::list<HostileReference*> const& l_ThreatList = me->getThreatManager().getThreatList();
+    ThreatContainer::StorageType const& l_ThreatList = me->getThreatManager().getThreatList();
     if (l_ThreatList.empty())
         return nullptr;
 
@@ -146,7 +146,7 @@ Player* UnitAI::SelectRangedTarget(bool p_AllowHeal /*= true*/, int32 p_CheckAur
 
 Player* UnitAI::SelectMeleeTarget(bool p_AllowTank /*= false*/) const
 {
-    std::list<HostileReference*> const& l_ThreatList = me->getThreatManager().getThreatList();
+    ThreatContainer::StorageType const& l_ThreatList = me->getThreatManager().getThreatList();
     if (l_ThreatList.empty())
         return nullptr;
 
@@ -178,7 +178,7 @@ Player* UnitAI::SelectMeleeTarget(bool p_AllowTank /*= false*/) const
 
 Player* UnitAI::SelectPlayerTarget(eTargetTypeMask p_TypeMask, std::vector<int32> p_ExcludeAuras /*= { }*/, float p_Dist /*= 0.0f*/)
 {
-    std::list<HostileReference*> const& l_ThreatList = me->getThreatManager().getThreatList();
+    ThreatContainer::StorageType const& l_ThreatList = me->getThreatManager().getThreatList();
     if (l_ThreatList.empty())
         return nullptr;
 
@@ -255,11 +255,11 @@ Player* UnitAI::SelectPlayerTarget(eTargetTypeMask p_TypeMask, std::vector<int32
 
 Player* UnitAI::SelectMainTank() const
 {
-    std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+    ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
     if (l_ThreatList.empty())
         return nullptr;
 
-    l_ThreatList.remove_if([this](HostileReference* p_HostileRef) -> bool
+    l_ThreatList.erase(std::remove_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
     {
         Player* l_Player = p_HostileRef->getTarget()->ToPlayer();
         if (l_Player == nullptr)
@@ -269,23 +269,23 @@ Player* UnitAI::SelectMainTank() const
             return true;
 
         return false;
-    });
+    }), l_ThreatList.end());
 
     if (l_ThreatList.empty())
         return nullptr;
 
-    l_ThreatList.sort(JadeCore::ThreatOrderPred());
+    std::stable_sort(l_ThreatList.begin(), l_ThreatList.end(), JadeCore::ThreatOrderPred());
 
     return l_ThreatList.front()->getTarget()->ToPlayer();
 }
 
 Player* UnitAI::SelectOffTank() const
 {
-    std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+    ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
     if (l_ThreatList.empty())
         return nullptr;
 
-    l_ThreatList.remove_if([this](HostileReference* p_HostileRef) -> bool
+    l_ThreatList.erase(std::remove_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
     {
         Player* l_Player = p_HostileRef->getTarget()->ToPlayer();
         if (l_Player == nullptr)
@@ -295,12 +295,12 @@ Player* UnitAI::SelectOffTank() const
             return true;
 
         return false;
-    });
+    }), l_ThreatList.end());
 
     if (l_ThreatList.empty())
         return nullptr;
 
-    l_ThreatList.sort(JadeCore::ThreatOrderPred());
+    std::stable_sort(l_ThreatList.begin(), l_ThreatList.end(), JadeCore::ThreatOrderPred());
 
     return l_ThreatList.back()->getTarget()->ToPlayer();
 }
@@ -315,8 +315,8 @@ void UnitAI::DoAddAuraToAllHostilePlayers(uint32 spellid)
 {
     if (me->isInCombat())
     {
-        std::list<HostileReference*>& threatlist = me->getThreatManager().getThreatList();
-        for (std::list<HostileReference*>::iterator itr = threatlist.begin(); itr != threatlist.end(); ++itr)
+        ThreatContainer::StorageType threatlist = me->getThreatManager().getThreatList();
+        for (ThreatContainer::StorageType::iterator itr = threatlist.begin(); itr != threatlist.end(); ++itr)
         {
             if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                 if (unit->IsPlayer())
@@ -329,8 +329,8 @@ void UnitAI::DoCastToAllHostilePlayers(uint32 spellid, bool triggered)
 {
     if (me->isInCombat())
     {
-        std::list<HostileReference*>& threatlist = me->getThreatManager().getThreatList();
-        for (std::list<HostileReference*>::iterator itr = threatlist.begin(); itr != threatlist.end(); ++itr)
+        ThreatContainer::StorageType threatlist = me->getThreatManager().getThreatList();
+        for (ThreatContainer::StorageType::iterator itr = threatlist.begin(); itr != threatlist.end(); ++itr)
         {
             if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                 if (unit->IsPlayer())
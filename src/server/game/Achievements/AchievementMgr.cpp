@@ -1310,6 +1310,9 @@ void AchievementMgr<T>::CheckAllAchievementCriteria(Player* p_ReferencePlayer)
     if (sWorld->getBoolConfig(CONFIG_ACHIEVEMENT_DISABLE))
         return;
 
+    /// The tasks read the knowledge snapshot, it must be up to date before they are queued
+    p_ReferencePlayer->RefreshKnowledgeSnapshot();
+
     for (uint32 l_AchievementCriteriaType = 0; l_AchievementCriteriaType < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++l_AchievementCriteriaType)
     {
         AchievementCriteriaUpdateTask l_Task;
@@ -1360,7 +1363,7 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes p_Typ
     if (IsGuild<T>() && !sWorld->getBoolConfig(CONFIG_GUILD_LEVELING_ENABLED))
         return;
 
-    AchievementCriteriaEntryList const& l_AchievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(p_Type);
+    AchievementCriteriaEntryList const& l_AchievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByTypeAndAsset(p_Type, p_MiscValue1);
     for (AchievementCriteriaEntryList::const_iterator i = l_AchievementCriteriaList.begin(); i != l_AchievementCriteriaList.end(); ++i)
     {
         CriteriaEntry const* l_AchievementCriteria = (*i);
@@ -1481,13 +1484,21 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes p_Typ
                 SetCriteriaProgress(l_AchievementCriteria, p_ReferencePlayer->getLevel(), p_ReferencePlayer);
                 break;
             case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
-                if (uint32 skillvalue = p_ReferencePlayer->GetBaseSkillValue(l_AchievementCriteria->reach_skill_level.skillID))
-                    SetCriteriaProgress(l_AchievementCriteria, skillvalue, p_ReferencePlayer);
+            {
+                PlayerKnowledgeSnapshotPtr l_Knowledge = p_ReferencePlayer->GetKnowledgeSnapshot();
+                PlayerKnowledgeSnapshot::Skill const* l_Skill = l_Knowledge ? l_Knowledge->GetSkill(l_AchievementCriteria->reach_skill_level.skillID) : nullptr;
+                if (l_Skill && l_Skill->BaseValue)
+                    SetCriteriaProgress(l_AchievementCriteria, l_Skill->BaseValue, p_ReferencePlayer);
                 break;
+            }
             case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
-                if (uint32 maxSkillvalue = p_ReferencePlayer->GetPureMaxSkillValue(l_AchievementCriteria->learn_skill_level.skillID))
-                    SetCriteriaProgress(l_AchievementCriteria, maxSkillvalue, p_ReferencePlayer);
+            {
+                PlayerKnowledgeSnapshotPtr l_Knowledge = p_ReferencePlayer->GetKnowledgeSnapshot();
+                PlayerKnowledgeSnapshot::Skill const* l_Skill = l_Knowledge ? l_Knowledge->GetSkill(l_AchievementCriteria->learn_skill_level.skillID) : nullptr;
+                if (l_Skill && l_Skill->PureMaxValue)
+                    SetCriteriaProgress(l_AchievementCriteria, l_Skill->PureMaxValue, p_ReferencePlayer);
                 break;
+            }
             case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT:
                 SetCriteriaProgress(l_AchievementCriteria, p_ReferencePlayer->GetRewardedQuestCount(), p_ReferencePlayer);
                 break;
@@ -1564,11 +1575,13 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes p_Typ
             case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
             {
                 uint32 spellCount = 0;
-                for (PlayerSpellMap::const_iterator spellIter = p_ReferencePlayer->GetSpellMap().begin();
-                    spellIter != p_ReferencePlayer->GetSpellMap().end();
-                    ++spellIter)
+                PlayerKnowledgeSnapshotPtr l_Knowledge = p_ReferencePlayer->GetKnowledgeSnapshot();
+                if (!l_Knowledge)
+                    break;
+
+                for (std::vector<uint32>::const_iterator spellIter = l_Knowledge->Spells.begin(); spellIter != l_Knowledge->Spells.end(); ++spellIter)
                 {
-                    SkillLineAbilityMapBounds bounds = sSpellMgr->GetSkillLineAbilityMapBounds(spellIter->first);
+                    SkillLineAbilityMapBounds bounds = sSpellMgr->GetSkillLineAbilityMapBounds(*spellIter);
                     for (SkillLineAbilityMap::const_iterator skillIter = bounds.first; skillIter != bounds.second; ++skillIter)
                     {
                         if (skillIter->second->skillId == l_AchievementCriteria->learn_skillline_spell.skillLine)
@@ -1590,11 +1603,13 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes p_Typ
             case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
             {
                 uint32 spellCount = 0;
-                for (PlayerSpellMap::const_iterator spellIter = p_ReferencePlayer->GetSpellMap().begin();
-                    spellIter != p_ReferencePlayer->GetSpellMap().end();
-                    ++spellIter)
+                PlayerKnowledgeSnapshotPtr l_Knowledge = p_ReferencePlayer->GetKnowledgeSnapshot();
+                if (!l_Knowledge)
+                    break;
+
+                for (std::vector<uint32>::const_iterator spellIter = l_Knowledge->Spells.begin(); spellIter != l_Knowledge->Spells.end(); ++spellIter)
                 {
-                    SkillLineAbilityMapBounds bounds = sSpellMgr->GetSkillLineAbilityMapBounds(spellIter->first);
+                    SkillLineAbilityMapBounds bounds = sSpellMgr->GetSkillLineAbilityMapBounds(*spellIter);
                     for (SkillLineAbilityMap::const_iterator skillIter = bounds.first; skillIter != bounds.second; ++skillIter)
                         if (skillIter->second->skillId == l_AchievementCriteria->learn_skill_line.skillLine)
                             spellCount++;
@@ -2463,9 +2478,18 @@ void AchievementMgr<T>::RewardAchievement(AchievementEntry const* p_Achievement)
 #endif
     }
 
-    /// Spell
-    if (l_Reward->SpellID)
-        GetOwner()->learnSpell(l_Reward->SpellID, false, false);
+    /// Spell, learnt by the thread updating the player because rewards are given from the criteria tasks
+    if (uint32 l_SpellID = l_Reward->SpellID)
+    {
+        uint64 l_PlayerGuid = GetOwner()->GetGUID();
+        GetOwner()->AddCriticalOperation([l_PlayerGuid, l_SpellID]() -> bool
+        {
+            if (Player* l_Player = sObjectAccessor->FindPlayer(l_PlayerGuid))
+                l_Player->learnSpell(l_SpellID, false, false);
+
+            return true;
+        });
+    }
 }
 
 #ifndef CROSS
@@ -2936,12 +2960,18 @@ bool AchievementMgr<T>::RequirementsSatisfied(CriteriaEntry const* p_Criteria, u
                 return false;
             break;
         case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        {
             if (p_MiscValue1 && p_MiscValue1 != p_Criteria->learn_spell.spellID)
                 return false;
 
-            if (!p_ReferencePlayer || !p_ReferencePlayer->HasSpell(p_Criteria->learn_spell.spellID))
+            if (!p_ReferencePlayer)
+                return false;
+
+            PlayerKnowledgeSnapshotPtr l_Knowledge = p_ReferencePlayer->GetKnowledgeSnapshot();
+            if (!l_Knowledge || !l_Knowledge->HasSpell(p_Criteria->learn_spell.spellID))
                 return false;
             break;
+        }
         case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
             // miscValue1 = itemId - miscValue2 = count of item loot
             // miscValue3 = loot_type (note: 0 = LOOT_CORPSE and then it ignored)
@@ -3495,11 +3525,17 @@ bool AchievementMgr<T>::AdditionalRequirementsSatisfied(CriteriaEntry const* p_C
                 break;
             }
             case CRITERIA_CONDITION_EARN_CURRENCY_DURING_ARENA_SEASON:  // 121
-                if (!p_ReferencePlayer || p_ReferencePlayer->GetCurrency(l_ReqValue, true) < l_SecondValue)
+            {
+                if (!p_ReferencePlayer)
+                    return false;
+
+                PlayerKnowledgeSnapshotPtr l_Knowledge = p_ReferencePlayer->GetKnowledgeSnapshot();
+                if (!l_Knowledge || l_Knowledge->GetCurrency(l_ReqValue, true) < l_SecondValue)
                     return false;
                 if (sWorld->getIntConfig(CONFIG_ARENA_SEASON_ID) != p_Criteria->EligibilityWorldStateValue)
                     return false;
                 break;
+            }
             case CRITERIA_CONDITION_REQUIRE_DEATH_IN_DUNGEON_OR_RAID:   // 122
                 if (!p_ReferencePlayer || p_ReferencePlayer->isAlive())
                     return false;
@@ -3854,6 +3890,9 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
 
         m_AchievementCriteriasByType[l_Criteria->Type].push_back(l_Criteria);
 
+        if (GetCriteriaAssetMatch(AchievementCriteriaTypes(l_Criteria->Type)) != CRITERIA_ASSET_MATCH_NONE)
+            m_AchievementCriteriasByTypeAndAsset[l_Criteria->Type][l_Criteria->raw.criteriaArg1].push_back(l_Criteria);
+
         if (l_Criteria->StartTimer)
             m_AchievementCriteriasByTimedType[l_Criteria->StartEvent].push_back(l_Criteria);
 
@@ -4216,29 +4255,184 @@ bool AchievementMgr<T>::RequiresScript(CriteriaEntry const* p_Criteria)
 
 void AchievementGlobalMgr::PrepareCriteriaUpdateTaskThread()
 {
+    /// Identical state based events of the same tick are coalesced, the first one keeps its place in the queue
+    using CoalesceKey = std::tuple<uint32, uint64, uint64, uint64, uint64, bool>;
+    std::set<CoalesceKey> l_Seen;
+
     AchievementCriteriaUpdateTask l_Task;
     for (auto l_Iterator = m_LockedPlayersAchievementCriteriaTask.begin(); l_Iterator != m_LockedPlayersAchievementCriteriaTask.end(); l_Iterator++)
     {
+        AchievementCriteriaTaskQueue* l_Queue = nullptr;
+        l_Seen.clear();
+
         while ((*l_Iterator).second.next(l_Task))
-            m_PlayersAchievementCriteriaTask[(*l_Iterator).first].push(l_Task);
+        {
+            if (l_Task.Type < ACHIEVEMENT_CRITERIA_TYPE_TOTAL && IsCoalescableCriteriaType(l_Task.Type))
+            {
+                if (!l_Seen.insert(CoalesceKey(l_Task.Type, l_Task.MiscValues[0], l_Task.MiscValues[1], l_Task.MiscValues[2], l_Task.UnitGUID, l_Task.LoginCheck)).second)
+                    continue;
+            }
+
+            if (l_Queue == nullptr)
+                l_Queue = &m_PlayersAchievementCriteriaTask[(*l_Iterator).first];
+
+            l_Queue->push_back(std::move(l_Task));
+        }
     }
 }
 
-AchievementCriteriaUpdateRequest::AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue p_TaskQueue)
-: MapUpdaterTask(p_Updater), m_CriteriaUpdateTasks(p_TaskQueue)
+AchievementGlobalMgr::~AchievementGlobalMgr()
 {
+    for (AchievementCriteriaUpdateRequest* l_Request : m_CriteriaUpdateRequestPool)
+        delete l_Request;
+}
 
+AchievementCriteriaAssetMatch AchievementGlobalMgr::GetCriteriaAssetMatch(AchievementCriteriaTypes p_Type)
+{
+    /// Must stay in sync with AchievementMgr<T>::RequirementsSatisfied, every type listed here
+    /// compares miscValue1 with the first criteria argument
+    switch (p_Type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_ACCEPTED_SUMMONINGS:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_DAILY_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_CREATE_AUCTION:
+        case ACHIEVEMENT_CRITERIA_TYPE_FALL_WITHOUT_DYING:
+        case ACHIEVEMENT_CRITERIA_TYPE_FLIGHT_PATHS_TAKEN:
+        case ACHIEVEMENT_CRITERIA_TYPE_GET_KILLING_BLOWS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_EARNED_BY_AUCTIONS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_AT_BARBER:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_MAIL:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_TALENTS:
+        case ACHIEVEMENT_CRITERIA_TYPE_GOLD_SPENT_FOR_TRAVELLING:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_BID:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_SOLD:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HEALING_RECEIVED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HEAL_CASTED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HIT_DEALT:
+        case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HIT_RECEIVED:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_MONEY:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOSE_DUEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_MONEY_FROM_QUEST_REWARD:
+        case ACHIEVEMENT_CRITERIA_TYPE_MONEY_FROM_VENDORS:
+        case ACHIEVEMENT_CRITERIA_TYPE_NUMBER_OF_TALENT_RESETS:
+        case ACHIEVEMENT_CRITERIA_TYPE_QUEST_ABANDONED:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_GUILD_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED:
+        case ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED:
+        case ACHIEVEMENT_CRITERIA_TYPE_SPECIAL_PVP_KILL:
+        case ACHIEVEMENT_CRITERIA_TYPE_TOTAL_DAMAGE_RECEIVED:
+        case ACHIEVEMENT_CRITERIA_TYPE_TOTAL_HEALING_RECEIVED:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_LFD_TO_GROUP_WITH_PLAYERS:
+        case ACHIEVEMENT_CRITERIA_TYPE_VISIT_BARBER_SHOP:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_DUEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_RATED_ARENA:
+        case ACHIEVEMENT_CRITERIA_TYPE_WON_AUCTIONS:
+        case ACHIEVEMENT_CRITERIA_TYPE_COOK_SOME_MEALS:
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_CHALLENGE_DUNGEON:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_CURRENCY:
+        case ACHIEVEMENT_CRITERIA_TYPE_DEFEAT_ENCOUNTER:
+            return CRITERIA_ASSET_MATCH_REQUIRED;
+        case ACHIEVEMENT_CRITERIA_TYPE_WIN_ARENA:
+            return CRITERIA_ASSET_MATCH_EXACT;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAPTURE_BATTLEPET:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEVELUP_BATTLEPET:
+            return CRITERIA_ASSET_MATCH_OPTIONAL;
+        default:
+            break;
+    }
+
+    return CRITERIA_ASSET_MATCH_NONE;
 }
 
-void AchievementCriteriaUpdateRequest::call()
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes p_Type, uint64 p_MiscValue1) const
 {
-    AchievementCriteriaUpdateTask l_Task;
-    while (!m_CriteriaUpdateTasks.empty())
+    static AchievementCriteriaEntryList const s_EmptyList;
+
+    switch (GetCriteriaAssetMatch(p_Type))
     {
-        l_Task = m_CriteriaUpdateTasks.front();
-        l_Task.Task(l_Task.PlayerGUID, l_Task.UnitGUID);
-        m_CriteriaUpdateTasks.pop();
+        case CRITERIA_ASSET_MATCH_NONE:
+            return m_AchievementCriteriasByType[p_Type];
+        case CRITERIA_ASSET_MATCH_REQUIRED:
+            if (!p_MiscValue1)
+                return s_EmptyList;
+            break;
+        case CRITERIA_ASSET_MATCH_OPTIONAL:
+            if (!p_MiscValue1)
+                return m_AchievementCriteriasByType[p_Type];
+            break;
+        default:
+            break;
     }
 
+    auto l_Itr = m_AchievementCriteriasByTypeAndAsset[p_Type].find(p_MiscValue1);
+    return l_Itr != m_AchievementCriteriasByTypeAndAsset[p_Type].end() ? l_Itr->second : s_EmptyList;
+}
+
+AchievementCriteriaUpdateRequest* AchievementGlobalMgr::AcquireCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue& p_Tasks)
+{
+    AchievementCriteriaUpdateRequest* l_Request = nullptr;
+
+    {
+        std::lock_guard<std::mutex> l_Guard(m_CriteriaUpdateRequestPoolLock);
+        if (!m_CriteriaUpdateRequestPool.empty())
+        {
+            l_Request = m_CriteriaUpdateRequestPool.back();
+            m_CriteriaUpdateRequestPool.pop_back();
+        }
+    }
+
+    if (l_Request == nullptr)
+        l_Request = new AchievementCriteriaUpdateRequest(p_Updater);
+
+    l_Request->Reset(p_Updater, p_Tasks);
+    return l_Request;
+}
+
+void AchievementGlobalMgr::ReleaseCriteriaUpdateRequest(AchievementCriteriaUpdateRequest* p_Request)
+{
+    std::lock_guard<std::mutex> l_Guard(m_CriteriaUpdateRequestPoolLock);
+    m_CriteriaUpdateRequestPool.push_back(p_Request);
+}
+
+AchievementCriteriaUpdateRequest::AchievementCriteriaUpdateRequest(MapUpdater* p_Updater)
+: MapUpdaterTask(p_Updater)
+{
+
+}
+
+void AchievementCriteriaUpdateRequest::call()
+{
+    for (AchievementCriteriaUpdateTask& l_Task : m_CriteriaUpdateTasks)
+        l_Task.Task(l_Task.PlayerGUID, l_Task.UnitGUID);
+
+    /// Keep the capacity, the storage is swapped back into the next batch
+    m_CriteriaUpdateTasks.clear();
+
     UpdateFinished();
 }
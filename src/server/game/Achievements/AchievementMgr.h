@@ -667,22 +667,43 @@ class AchievementMgr
 
 struct AchievementCriteriaUpdateTask
 {
+    AchievementCriteriaUpdateTask() : PlayerGUID(0), UnitGUID(0), Type(ACHIEVEMENT_CRITERIA_TYPE_TOTAL), LoginCheck(false)
+    {
+        MiscValues[0] = MiscValues[1] = MiscValues[2] = 0;
+    }
+
     uint64 PlayerGUID;
     uint64 UnitGUID;
     std::function<void(uint64, uint64)> Task;
+
+    /// Event description, used to coalesce identical events of the same tick
+    AchievementCriteriaTypes Type;
+    uint64 MiscValues[3];
+    bool LoginCheck;
 };
 
 using LockedAchievementCriteriaTaskQueue   = ACE_Based::LockedQueue<AchievementCriteriaUpdateTask, ACE_Thread_Mutex>;
 using LockedPlayersAchievementCriteriaTask = ACE_Based::LockedMap<uint64, LockedAchievementCriteriaTaskQueue>;
 
-using AchievementCriteriaTaskQueue   = std::queue<AchievementCriteriaUpdateTask>;
-using PlayersAchievementCriteriaTask = std::map<uint32, AchievementCriteriaTaskQueue>;
+using AchievementCriteriaTaskQueue   = std::vector<AchievementCriteriaUpdateTask>;
+using PlayersAchievementCriteriaTask = std::map<uint64, AchievementCriteriaTaskQueue>;
+
+class AchievementCriteriaUpdateRequest;
+
+/// How UpdateAchievementCriteria filters the criteria of a type with the first misc value
+enum AchievementCriteriaAssetMatch
+{
+    CRITERIA_ASSET_MATCH_NONE,          ///< No filter on the asset, every criteria of the type is checked
+    CRITERIA_ASSET_MATCH_REQUIRED,      ///< Only criteria with asset == miscValue1, nothing when miscValue1 is 0
+    CRITERIA_ASSET_MATCH_EXACT,         ///< Only criteria with asset == miscValue1, 0 included
+    CRITERIA_ASSET_MATCH_OPTIONAL       ///< Only criteria with asset == miscValue1, every criteria when miscValue1 is 0
+};
 
 class AchievementGlobalMgr
 {
         friend class ACE_Singleton<AchievementGlobalMgr, ACE_Null_Mutex>;
         AchievementGlobalMgr() {}
-        ~AchievementGlobalMgr() {}
+        ~AchievementGlobalMgr();
 
     public:
         static char const* GetCriteriaTypeString(uint32 type);
@@ -692,6 +713,11 @@ class AchievementGlobalMgr
             return m_AchievementCriteriasByType[type];
         }
 
+        /// Criteria of the type which can be updated by an event with the given first misc value, see RequirementsSatisfied
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes p_Type, uint64 p_MiscValue1) const;
+
+        static AchievementCriteriaAssetMatch GetCriteriaAssetMatch(AchievementCriteriaTypes p_Type);
+
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
             return m_AchievementCriteriasByTimedType[type];
@@ -781,6 +807,51 @@ class AchievementGlobalMgr
             return false;
         }
 
+        /// Criteria types whose progress only depends on the event values and the player state,
+        /// an identical event triggered twice in the same tick gives the same result as a single one
+        bool IsCoalescableCriteriaType(AchievementCriteriaTypes p_Type) const
+        {
+            switch (p_Type)
+            {
+                case ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL:
+                case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+                case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+                case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST_COUNT:
+                case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+                case ACHIEVEMENT_CRITERIA_TYPE_FALL_WITHOUT_DYING:
+                case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+                case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+                case ACHIEVEMENT_CRITERIA_TYPE_EXPLORE_AREA:
+                case ACHIEVEMENT_CRITERIA_TYPE_VISIT_BARBER_SHOP:
+                case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_EPIC_ITEM:
+                case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+                case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT:
+                case ACHIEVEMENT_CRITERIA_TYPE_BUY_BANK_SLOT:
+                case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+                case ACHIEVEMENT_CRITERIA_TYPE_GAIN_EXALTED_REPUTATION:
+                case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REVERED_REPUTATION:
+                case ACHIEVEMENT_CRITERIA_TYPE_GAIN_HONORED_REPUTATION:
+                case ACHIEVEMENT_CRITERIA_TYPE_KNOWN_FACTIONS:
+                case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+                case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+                case ACHIEVEMENT_CRITERIA_TYPE_EARN_HONORABLE_KILL:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_GOLD_VALUE_OWNED:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_BID:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_SOLD:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HIT_DEALT:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HIT_RECEIVED:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HEAL_CASTED:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_HEALING_RECEIVED:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_TEAM_RATING:
+                case ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_PERSONAL_RATING:
+                    return true;
+                default:
+                    break;
+            }
+
+            return false;
+        }
+
         void LoadAchievementCriteriaList();
         void LoadAchievementCriteriaData();
         void LoadAchievementReferenceList();
@@ -801,7 +872,7 @@ class AchievementGlobalMgr
             m_LockedPlayersAchievementCriteriaTask[p_Task.PlayerGUID].add(p_Task);
         }
 
-        PlayersAchievementCriteriaTask const& GetPlayersCriteriaTask() const
+        PlayersAchievementCriteriaTask& GetPlayersCriteriaTask()
         {
             return m_PlayersAchievementCriteriaTask;
         }
@@ -811,11 +882,17 @@ class AchievementGlobalMgr
             m_PlayersAchievementCriteriaTask.clear();
         }
 
+        /// Take a request from the pool, the tasks are moved out of p_Tasks
+        AchievementCriteriaUpdateRequest* AcquireCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue& p_Tasks);
+        void ReleaseCriteriaUpdateRequest(AchievementCriteriaUpdateRequest* p_Request);
+
     private:
         AchievementCriteriaDataMap m_criteriaDataMap;
 
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // same, split by asset (first criteria argument) for the types filtered on miscValue1
+        std::unordered_map<uint64, AchievementCriteriaEntryList> m_AchievementCriteriasByTypeAndAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
 
         AchievementCriteriaEntryList m_AchievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
 
@@ -836,6 +913,9 @@ class AchievementGlobalMgr
 
         LockedPlayersAchievementCriteriaTask m_LockedPlayersAchievementCriteriaTask;  ///< All criteria update task are first storing here
         PlayersAchievementCriteriaTask       m_PlayersAchievementCriteriaTask;        ///< Before thread process, all task stored will be move here
+
+        std::mutex m_CriteriaUpdateRequestPoolLock;
+        std::vector<AchievementCriteriaUpdateRequest*> m_CriteriaUpdateRequestPool;   ///< Requests are released from the map updater threads
 };
 
 #define sAchievementMgr ACE_Singleton<AchievementGlobalMgr, ACE_Null_Mutex>::instance()
@@ -844,8 +924,19 @@ class MapUpdater;
 class AchievementCriteriaUpdateRequest : public MapUpdaterTask
 {
     public:
-        AchievementCriteriaUpdateRequest(MapUpdater* p_Updater, AchievementCriteriaTaskQueue p_TaskQueue);
+        AchievementCriteriaUpdateRequest(MapUpdater* p_Updater);
         virtual void call() override;
+        char const* GetName() const override { return "AchievementCriteriaUpdate"; }
+        uint32 GetCost() const override { return uint32(m_CriteriaUpdateTasks.size()); }
+
+        void Release() override { sAchievementMgr->ReleaseCriteriaUpdateRequest(this); }
+
+        /// Swap the queue, the previous task storage is given back to the caller to be reused
+        void Reset(MapUpdater* p_Updater, AchievementCriteriaTaskQueue& p_Tasks)
+        {
+            m_updater = p_Updater;
+            m_CriteriaUpdateTasks.swap(p_Tasks);
+        }
 
     private:
         AchievementCriteriaTaskQueue m_CriteriaUpdateTasks;
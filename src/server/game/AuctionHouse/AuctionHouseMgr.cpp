@@ -23,9 +23,75 @@
 
 enum eAuctionHouse
 {
-    AH_MINIMUM_DEPOSIT = 100
+    AH_MINIMUM_DEPOSIT      = 100,
+    AH_MAX_CACHED_SEARCHES  = 256,
+    AH_SEARCH_PAGE_SIZE     = 50
 };
 
+/// Pack 3 wide chars of a lowercase name, names only use the BMP so 21 bits per char is enough
+static uint64 PackAuctionNameTrigram(std::wstring const& p_Name, size_t p_Pos)
+{
+    return (uint64(p_Name[p_Pos] & 0x1FFFFF) << 42) | (uint64(p_Name[p_Pos + 1] & 0x1FFFFF) << 21) | uint64(p_Name[p_Pos + 2] & 0x1FFFFF);
+}
+
+/// Posting lists are sorted vectors, auction ids mostly grow so an insert is usually a push_back
+static void InsertSortedAuctionId(std::vector<uint32>& p_List, uint32 p_AuctionId)
+{
+    if (p_List.empty() || p_List.back() < p_AuctionId)
+    {
+        p_List.push_back(p_AuctionId);
+        return;
+    }
+
+    std::vector<uint32>::iterator l_Itr = std::lower_bound(p_List.begin(), p_List.end(), p_AuctionId);
+    if (*l_Itr != p_AuctionId)
+        p_List.insert(l_Itr, p_AuctionId);
+}
+
+static void EraseSortedAuctionId(std::vector<uint32>& p_List, uint32 p_AuctionId)
+{
+    std::vector<uint32>::iterator l_Itr = std::lower_bound(p_List.begin(), p_List.end(), p_AuctionId);
+    if (l_Itr != p_List.end() && *l_Itr == p_AuctionId)
+        p_List.erase(l_Itr);
+}
+
+/// Localized lowercase name of an auctioned item as searched by the client, empty if the item has no name
+static std::wstring BuildAuctionSearchName(AuctionSearchInfo const& p_Info, int p_LocaleIdx)
+{
+    ItemTemplate const* l_Proto = sObjectMgr->GetItemTemplate(p_Info.ItemEntry);
+    if (!l_Proto || !l_Proto->Name1)
+        return std::wstring();
+
+    std::string l_Name = l_Proto->Name1->Get(p_LocaleIdx);
+    if (l_Name.empty())
+        return std::wstring();
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    if (p_Info.RandomPropertyId)
+    {
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+        //  even though the DBC names seem misleading
+        if (ItemRandomPropertiesEntry const* l_RandomProperty = sItemRandomPropertiesStore.LookupEntry(p_Info.RandomPropertyId))
+        {
+            if (l_RandomProperty->nameSuffix && *l_RandomProperty->nameSuffix)
+            {
+                l_Name += ' ';
+                l_Name += l_RandomProperty->nameSuffix;
+            }
+        }
+    }
+
+    std::wstring l_WideName;
+    if (!Utf8toWStr(l_Name, l_WideName))
+        return std::wstring();
+
+    wstrToLower(l_WideName);
+    return l_WideName;
+}
+
 AuctionHouseMgr::AuctionHouseMgr()
 {
 }
@@ -408,12 +474,15 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    m_ExpireQueue.push(std::make_pair(auction->expire_time, auction->Id));
+    AddToSearchIndex(auction);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    RemoveFromSearchIndex(auction->Id);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -431,22 +500,23 @@ void AuctionHouseObject::Update()
     if (AuctionsMap.empty())
         return;
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_AUCTION_BY_TIME);
-    stmt->setUInt32(0, (uint32)curTime+60);
-    
-    PreparedQueryResult l_Result = CharacterDatabase.Query(stmt);
-    if (!l_Result)
-        return;
+    /// Same one minute margin as the former CHAR_SEL_AUCTION_BY_TIME query
+    time_t l_ExpireLimit = curTime + 60;
 
-    do
+    SQLTransaction trans;
+
+    while (!m_ExpireQueue.empty() && m_ExpireQueue.top().first <= l_ExpireLimit)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(l_Result->Fetch()->GetUInt32());
+        AuctionExpireEntry l_Top = m_ExpireQueue.top();
+        m_ExpireQueue.pop();
 
-        if (!auction)
+        // Entries of removed or rescheduled auctions are dropped lazily
+        AuctionEntry* auction = GetAuction(l_Top.second);
+        if (!auction || auction->expire_time != l_Top.first)
             continue;
 
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        if (!trans)
+            trans = CharacterDatabase.BeginTransaction();
 
         ///- Either cancel the auction if there was no bidder
         if (auction->bidder == 0)
@@ -469,12 +539,14 @@ void AuctionHouseObject::Update()
 
         ///- In any case clear the auction
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
 
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
         RemoveAuction(auction, itemEntry);
     }
-    while (l_Result->NextRow());
+
+    /// Every auction expired during this tick is flushed in a single async transaction
+    if (trans)
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -507,84 +579,289 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
-    std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
-    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
-    uint32& count, uint32& totalcount)
+void AuctionHouseObject::AddToSearchIndex(AuctionEntry const* p_Auction)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
+    ItemTemplate const* l_Proto = sObjectMgr->GetItemTemplate(p_Auction->itemEntry);
+    if (!l_Proto)
+        return;
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
-    {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
+    Item* l_Item = sAuctionMgr->GetAItem(p_Auction->itemGUIDLow);
 
-        ItemTemplate const* proto = item->GetTemplate();
+    AuctionSearchInfo& l_Info = m_SearchInfos[p_Auction->Id];
+    l_Info.ItemEntry        = p_Auction->itemEntry;
+    l_Info.ItemClass        = l_Proto->Class;
+    l_Info.ItemSubClass     = l_Proto->SubClass;
+    l_Info.InventoryType    = l_Proto->InventoryType;
+    l_Info.Quality          = l_Proto->Quality;
+    l_Info.RequiredLevel    = l_Proto->RequiredLevel;
+    l_Info.RandomPropertyId = l_Item ? l_Item->GetItemRandomPropertyId() : 0;
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+    InsertSortedAuctionId(m_ByClass[l_Info.ItemClass], p_Auction->Id);
+    InsertSortedAuctionId(m_BySubClass[(l_Info.ItemClass << 16) | l_Info.ItemSubClass], p_Auction->Id);
+    InsertSortedAuctionId(m_ByInventoryType[l_Info.InventoryType], p_Auction->Id);
+    InsertSortedAuctionId(m_ByQuality[l_Info.Quality], p_Auction->Id);
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
+    for (auto& l_Pair : m_NameIndexes)
+        AddToNameIndex(l_Pair.second, p_Auction->Id, l_Info, l_Pair.first);
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
+    InvalidateSearchCache(p_Auction->Id);
+}
 
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
+void AuctionHouseObject::RemoveFromSearchIndex(uint32 p_AuctionId)
+{
+    auto l_Itr = m_SearchInfos.find(p_AuctionId);
+    if (l_Itr == m_SearchInfos.end())
+        return;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
+    InvalidateSearchCache(p_AuctionId);
+
+    AuctionSearchInfo const& l_Info = l_Itr->second;
+
+    auto l_EraseFromBucket = [p_AuctionId](AuctionSearchBuckets& p_Buckets, uint32 p_Key) -> void
+    {
+        auto l_Bucket = p_Buckets.find(p_Key);
+        if (l_Bucket == p_Buckets.end())
+            return;
+
+        EraseSortedAuctionId(l_Bucket->second, p_AuctionId);
+        if (l_Bucket->second.empty())
+            p_Buckets.erase(l_Bucket);
+    };
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+    l_EraseFromBucket(m_ByClass, l_Info.ItemClass);
+    l_EraseFromBucket(m_BySubClass, (l_Info.ItemClass << 16) | l_Info.ItemSubClass);
+    l_EraseFromBucket(m_ByInventoryType, l_Info.InventoryType);
+    l_EraseFromBucket(m_ByQuality, l_Info.Quality);
+
+    for (auto& l_Pair : m_NameIndexes)
+    {
+        AuctionNameIndex& l_Index = l_Pair.second;
+
+        auto l_Name = l_Index.Names.find(p_AuctionId);
+        if (l_Name == l_Index.Names.end())
             continue;
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
+        for (size_t l_I = 0; l_I + 3 <= l_Name->second.size(); ++l_I)
         {
-            std::string name = proto->Name1->Get(loc_idx);
-            if (name.empty())
+            auto l_Trigram = l_Index.Trigrams.find(PackAuctionNameTrigram(l_Name->second, l_I));
+            if (l_Trigram == l_Index.Trigrams.end())
                 continue;
 
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
+            EraseSortedAuctionId(l_Trigram->second, p_AuctionId);
+            if (l_Trigram->second.empty())
+                l_Index.Trigrams.erase(l_Trigram);
+        }
+
+        l_Index.Names.erase(l_Name);
+    }
+
+    m_SearchInfos.erase(l_Itr);
+}
+
+void AuctionHouseObject::InvalidateSearchCache(uint32 p_AuctionId)
+{
+    for (auto l_Itr = m_SearchCache.begin(); l_Itr != m_SearchCache.end();)
+    {
+        AuctionSearchQuery const& l_Query = l_Itr->first;
+
+        /// Queries with a name were cached with the name index of their locale, without it the match can't be told
+        AuctionNameIndex const* l_NameIndex = nullptr;
+        if (!l_Query.Name.empty())
+        {
+            auto l_Index = m_NameIndexes.find(int(l_Query.LocaleKey) - 1);
+            if (l_Index != m_NameIndexes.end())
+                l_NameIndex = &l_Index->second;
+        }
+
+        if ((!l_Query.Name.empty() && !l_NameIndex) || MatchesSearch(l_Query, p_AuctionId, l_NameIndex))
+            l_Itr = m_SearchCache.erase(l_Itr);
+        else
+            ++l_Itr;
+    }
+}
+
+void AuctionHouseObject::AddToNameIndex(AuctionNameIndex& p_Index, uint32 p_AuctionId, AuctionSearchInfo const& p_Info, int p_LocaleIdx)
+{
+    std::wstring l_Name = BuildAuctionSearchName(p_Info, p_LocaleIdx);
+    if (l_Name.empty())
+        return;
+
+    for (size_t l_I = 0; l_I + 3 <= l_Name.size(); ++l_I)
+        InsertSortedAuctionId(p_Index.Trigrams[PackAuctionNameTrigram(l_Name, l_I)], p_AuctionId);
+
+    p_Index.Names[p_AuctionId] = std::move(l_Name);
+}
 
-            if (propRefID)
+AuctionNameIndex& AuctionHouseObject::GetNameIndex(int p_LocaleIdx)
+{
+    auto l_Itr = m_NameIndexes.find(p_LocaleIdx);
+    if (l_Itr != m_NameIndexes.end())
+        return l_Itr->second;
+
+    AuctionNameIndex& l_Index = m_NameIndexes[p_LocaleIdx];
+    for (auto const& l_Pair : m_SearchInfos)
+        AddToNameIndex(l_Index, l_Pair.first, l_Pair.second, p_LocaleIdx);
+
+    return l_Index;
+}
+
+std::vector<uint32> const& AuctionHouseObject::GetSearchMatches(AuctionSearchQuery const& p_Query, int p_LocaleIdx)
+{
+    auto l_Cached = m_SearchCache.find(p_Query);
+    if (l_Cached != m_SearchCache.end())
+        return l_Cached->second;
+
+    if (m_SearchCache.size() >= AH_MAX_CACHED_SEARCHES)
+        m_SearchCache.clear();
+
+    std::vector<uint32>& l_Matches = m_SearchCache[p_Query];
+
+    AuctionNameIndex* l_NameIndex = p_Query.Name.empty() ? nullptr : &GetNameIndex(p_LocaleIdx);
+
+    /// Walk the smallest bucket matching one of the criteria, every other criteria is checked on the cached fields
+    std::vector<uint32> const* l_Candidates = nullptr;
+    bool l_NoMatch = false;
+
+    auto l_SelectBucket = [&l_Candidates, &l_NoMatch](AuctionSearchBuckets const& p_Buckets, uint32 p_Key) -> void
+    {
+        auto l_Bucket = p_Buckets.find(p_Key);
+        if (l_Bucket == p_Buckets.end())
+            l_NoMatch = true;
+        else if (!l_Candidates || l_Bucket->second.size() < l_Candidates->size())
+            l_Candidates = &l_Bucket->second;
+    };
+
+    if (p_Query.ItemClass != 0xffffffff && p_Query.ItemSubClass != 0xffffffff)
+        l_SelectBucket(m_BySubClass, (p_Query.ItemClass << 16) | p_Query.ItemSubClass);
+    else if (p_Query.ItemClass != 0xffffffff)
+        l_SelectBucket(m_ByClass, p_Query.ItemClass);
+
+    if (p_Query.InventoryType != 0xffffffff)
+        l_SelectBucket(m_ByInventoryType, p_Query.InventoryType);
+
+    if (p_Query.Quality != 0xffffffff)
+        l_SelectBucket(m_ByQuality, p_Query.Quality);
+
+    if (l_NameIndex && p_Query.Name.size() >= 3)
+    {
+        for (size_t l_I = 0; l_I + 3 <= p_Query.Name.size(); ++l_I)
+        {
+            auto l_Trigram = l_NameIndex->Trigrams.find(PackAuctionNameTrigram(p_Query.Name, l_I));
+            if (l_Trigram == l_NameIndex->Trigrams.end())
             {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
+                l_NoMatch = true;
+                break;
             }
 
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
+            if (!l_Candidates || l_Trigram->second.size() < l_Candidates->size())
+                l_Candidates = &l_Trigram->second;
+        }
+    }
+
+    if (l_NoMatch)
+        return l_Matches;
+
+    if (l_Candidates)
+    {
+        for (uint32 l_AuctionId : *l_Candidates)
+        {
+            if (MatchesSearch(p_Query, l_AuctionId, l_NameIndex))
+                l_Matches.push_back(l_AuctionId);
+        }
+    }
+    else
+    {
+        for (AuctionEntryMap::const_iterator l_Itr = AuctionsMap.begin(); l_Itr != AuctionsMap.end(); ++l_Itr)
+        {
+            if (MatchesSearch(p_Query, l_Itr->first, l_NameIndex))
+                l_Matches.push_back(l_Itr->first);
+        }
+    }
+
+    return l_Matches;
+}
+
+bool AuctionHouseObject::MatchesSearch(AuctionSearchQuery const& p_Query, uint32 p_AuctionId, AuctionNameIndex const* p_NameIndex) const
+{
+    auto l_Info = m_SearchInfos.find(p_AuctionId);
+    if (l_Info == m_SearchInfos.end())
+        return false;
+
+    AuctionSearchInfo const& l_Fields = l_Info->second;
+
+    if (p_Query.ItemClass != 0xffffffff && l_Fields.ItemClass != p_Query.ItemClass)
+        return false;
+
+    if (p_Query.ItemSubClass != 0xffffffff && l_Fields.ItemSubClass != p_Query.ItemSubClass)
+        return false;
+
+    if (p_Query.InventoryType != 0xffffffff && l_Fields.InventoryType != p_Query.InventoryType)
+        return false;
+
+    if (p_Query.Quality != 0xffffffff && l_Fields.Quality != p_Query.Quality)
+        return false;
+
+    if (p_Query.LevelMin != 0x00 && (l_Fields.RequiredLevel < p_Query.LevelMin || (p_Query.LevelMax != 0x00 && l_Fields.RequiredLevel > p_Query.LevelMax)))
+        return false;
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    if (p_NameIndex)
+    {
+        auto l_Name = p_NameIndex->Names.find(p_AuctionId);
+        if (l_Name == p_NameIndex->Names.end() || l_Name->second.find(p_Query.Name) == std::wstring::npos)
+            return false;
+    }
+
+    return true;
+}
+
+void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player,
+    std::wstring const& wsearchedname, uint32 listfrom, uint8 levelmin, uint8 levelmax, uint8 usable,
+    uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
+    uint32& count, uint32& totalcount)
+{
+    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
+
+    AuctionSearchQuery l_Query;
+    l_Query.Name          = wsearchedname;
+    l_Query.LocaleKey     = wsearchedname.empty() ? 0 : uint32(loc_idx + 1);
+    l_Query.LevelMin      = levelmin;
+    l_Query.LevelMax      = levelmax;
+    l_Query.InventoryType = inventoryType;
+    l_Query.ItemClass     = itemClass;
+    l_Query.ItemSubClass  = itemSubClass;
+    l_Query.Quality       = quality;
+
+    std::vector<uint32> const& l_Matches = GetSearchMatches(l_Query, loc_idx);
+
+    /// Without the usable filter the match list is the final result, only the requested page is built
+    if (usable == 0x00)
+    {
+        totalcount = uint32(l_Matches.size());
+
+        for (size_t l_I = listfrom; l_I < l_Matches.size() && count < AH_SEARCH_PAGE_SIZE; ++l_I)
+        {
+            AuctionEntry* l_Auction = GetAuction(l_Matches[l_I]);
+            if (!l_Auction || !l_Auction->BuildAuctionInfo(data))
                 continue;
+
+            ++count;
         }
 
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
+        return;
+    }
+
+    for (uint32 l_AuctionId : l_Matches)
+    {
+        AuctionEntry* Aentry = GetAuction(l_AuctionId);
+        if (!Aentry)
+            continue;
+
+        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
+        if (!item || player->CanUseItem(item) != EQUIP_ERR_OK)
+            continue;
+
+        if (count < AH_SEARCH_PAGE_SIZE && totalcount >= listfrom)
         {
             ++count;
             Aentry->BuildAuctionInfo(data);
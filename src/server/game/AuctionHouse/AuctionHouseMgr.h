@@ -14,6 +14,9 @@
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
 
+#include <queue>
+#include <tuple>
+
 class Item;
 class Player;
 class WorldPacket;
@@ -83,6 +86,44 @@ struct AuctionEntry
     static std::string BuildAuctionMailBody(uint32 p_LowGUID, uint64 p_BID, uint64 p_Buyout, uint64 p_Deposit, uint64 p_Cut);
 };
 
+/// Item template fields of an auction, cached to filter browse queries without resolving the item
+struct AuctionSearchInfo
+{
+    uint32 ItemEntry;
+    uint32 ItemClass;
+    uint32 ItemSubClass;
+    uint32 InventoryType;
+    uint32 Quality;
+    uint32 RequiredLevel;
+    int32 RandomPropertyId;
+};
+
+/// Lowercase item names of every auction for one client locale, with a trigram index for substring searches
+struct AuctionNameIndex
+{
+    std::unordered_map<uint32, std::wstring> Names;                 ///< auction id -> lowercase name (random suffix included)
+    std::unordered_map<uint64, std::vector<uint32>> Trigrams;       ///< packed 3 chars -> sorted auction ids
+};
+
+/// Every template based criteria of CMSG_AUCTION_LIST_ITEMS, used as key of the result cache
+struct AuctionSearchQuery
+{
+    std::wstring Name;
+    uint32 LocaleKey;
+    uint8 LevelMin;
+    uint8 LevelMax;
+    uint32 InventoryType;
+    uint32 ItemClass;
+    uint32 ItemSubClass;
+    uint32 Quality;
+
+    bool operator<(AuctionSearchQuery const& p_Other) const
+    {
+        return std::tie(Name, LocaleKey, LevelMin, LevelMax, InventoryType, ItemClass, ItemSubClass, Quality)
+            < std::tie(p_Other.Name, p_Other.LocaleKey, p_Other.LevelMin, p_Other.LevelMax, p_Other.InventoryType, p_Other.ItemClass, p_Other.ItemSubClass, p_Other.Quality);
+    }
+};
+
 //this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -122,10 +163,37 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount);
 
   private:
+    typedef std::unordered_map<uint32, std::vector<uint32>> AuctionSearchBuckets;   ///< key -> sorted auction ids
+    typedef std::pair<time_t, uint32> AuctionExpireEntry;               ///< expire time, auction id
+    typedef std::priority_queue<AuctionExpireEntry, std::vector<AuctionExpireEntry>, std::greater<AuctionExpireEntry>> AuctionExpireQueue;
+
+    void AddToSearchIndex(AuctionEntry const* p_Auction);
+    void RemoveFromSearchIndex(uint32 p_AuctionId);
+    void AddToNameIndex(AuctionNameIndex& p_Index, uint32 p_AuctionId, AuctionSearchInfo const& p_Info, int p_LocaleIdx);
+    AuctionNameIndex& GetNameIndex(int p_LocaleIdx);
+    std::vector<uint32> const& GetSearchMatches(AuctionSearchQuery const& p_Query, int p_LocaleIdx);
+    bool MatchesSearch(AuctionSearchQuery const& p_Query, uint32 p_AuctionId, AuctionNameIndex const* p_NameIndex) const;
+    /// Drop the cached queries the auction is (or was) a match of, called while it is still indexed
+    void InvalidateSearchCache(uint32 p_AuctionId);
+
     AuctionEntryMap AuctionsMap;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
+
+    /// Auctions ordered by expire time, filled by AddAuction, stale entries are skipped by Update()
+    AuctionExpireQueue m_ExpireQueue;
+
+    /// Browse indexes, kept in sync by AddAuction / RemoveAuction, buckets are ordered by auction id like AuctionsMap
+    std::unordered_map<uint32, AuctionSearchInfo> m_SearchInfos;
+    AuctionSearchBuckets m_ByClass;
+    AuctionSearchBuckets m_BySubClass;                              ///< (class << 16) | subclass
+    AuctionSearchBuckets m_ByInventoryType;
+    AuctionSearchBuckets m_ByQuality;
+    std::map<int, AuctionNameIndex> m_NameIndexes;                 ///< Built on first search for a locale
+
+    /// Matching auction ids of recent queries, every page of a query is served from the same list
+    std::map<AuctionSearchQuery, std::vector<uint32>> m_SearchCache;
 };
 
 class AuctionHouseMgr
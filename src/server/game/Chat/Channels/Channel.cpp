@@ -858,6 +858,8 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
 {
+    SharedWorldPacket l_SharedData = data->Share();
+
     m_Lock.acquire();
     for (PlayerList::const_iterator i = m_Players.begin(); i != m_Players.end(); ++i)
     {
@@ -868,13 +870,13 @@ void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
             if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
             {
                 if (IsWorld() || IsConstant())
-                    player->GetSession()->SendPacket(data);
+                    player->GetSession()->SendSharedPacket(l_SharedData);
                 else if (!(IsWorld() || IsConstant()))
-                    player->GetSession()->SendPacket(data);
+                    player->GetSession()->SendSharedPacket(l_SharedData);
             }
 #else /* CROSS */
             if (!p || !player->GetSocial() || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendSharedPacket(l_SharedData);
 #endif /* CROSS */
         }
     }
@@ -883,6 +885,8 @@ void Channel::SendToAll(WorldPacket* data, uint64 p, uint64 p_SenderGUID)
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
+    SharedWorldPacket l_SharedData = data->Share();
+
     m_Lock.acquire();
     for (PlayerList::const_iterator i = m_Players.begin(); i != m_Players.end(); ++i)
     {
@@ -890,7 +894,7 @@ void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
         {
             Player* player = ObjectAccessor::FindPlayer(i->first);
             if (player)
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendSharedPacket(l_SharedData);
         }
     }
     m_Lock.release();
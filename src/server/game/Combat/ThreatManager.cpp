@@ -243,7 +243,7 @@ Unit* HostileReference::getSourceUnit()
 
 void ThreatContainer::clearReferences()
 {
-    for (std::list<HostileReference*>::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for (StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
     {
         (*i)->unlink();
         delete (*i);
@@ -251,6 +251,16 @@ void ThreatContainer::clearReferences()
     iThreatList.clear();
 }
 
+//============================================================
+// Keep the order of the others, the list stays sorted
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    StorageType::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), hostileRef);
+    if (itr != iThreatList.end())
+        iThreatList.erase(itr);
+}
+
 //============================================================
 // Return the HostileReference of NULL, if not found
 HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
@@ -259,7 +269,7 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
         return NULL;
 
     uint64 guid = victim->GetGUID();
-    for (std::list<HostileReference*>::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for (StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
         if ((*i) && (*i)->getUnitGuid() == guid)
             return (*i);
 
@@ -290,8 +300,22 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(JadeCore::ThreatOrderPred());
+    // Insertion sort, stable for equal threats. Cost is the list size plus the total distance moved,
+    // cheap for the usual few changes but quadratic when most threats change at once (threat wipe)
+    if (iDirty)
+    {
+        for (size_t i = 1; i < iThreatList.size(); ++i)
+        {
+            HostileReference* ref = iThreatList[i];
+            float threat = ref->getThreat();
+
+            size_t j = i;
+            for (; j > 0 && iThreatList[j - 1]->getThreat() < threat; --j)
+                iThreatList[j] = iThreatList[j - 1];
+
+            iThreatList[j] = ref;
+        }
+    }
 
     iDirty = false;
 }
@@ -306,10 +330,13 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
     bool found = false;
     bool noPriorityTargetFound = false;
 
-    std::list<HostileReference*>::const_iterator lastRef = iThreatList.end();
+    if (iThreatList.empty())
+        return NULL;
+
+    StorageType::const_iterator lastRef = iThreatList.end();
     --lastRef;
 
-    for (std::list<HostileReference*>::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    for (StorageType::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
     {
         currentRef = (*iter);
 
@@ -570,25 +597,20 @@ bool ThreatManager::isNeedUpdateToClient(uint32 time)
 // Reset all aggro without modifying the threadlist.
 void ThreatManager::resetAllAggro()
 {
-    std::list<HostileReference*> &threatList = getThreatList();
+    ThreatContainer::StorageType &threatList = getThreatList();
     if (threatList.empty())
         return;
 
-    for (std::list<HostileReference*>::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
-    {
-        (*itr)->setThreat(0);
-    }
+    // setThreat can add the owner of a pet to the list, indexes survive the reallocation
+    for (uint32 i = 0; i < threatList.size(); ++i)
+        threatList[i]->setThreat(0);
 
     setDirty(true);
 }
 
 bool ThreatManager::HaveInThreatList(uint64 p_Guid) const
 {
-    std::list<HostileReference*> l_ThreatList = GetThreatList();
-    if (l_ThreatList.empty())
-        return false;
-
-    for (HostileReference* l_Iter : l_ThreatList)
+    for (HostileReference* l_Iter : GetThreatList())
     {
         if (p_Guid == l_Iter->getUnitGuid())
             return true;
@@ -130,13 +130,17 @@ class ThreatManager;
 
 class ThreatContainer
 {
+    public:
+        /// Contiguous and sorted by decreasing threat once update() ran, a reference added or removed while iterating moves the others
+        typedef std::vector<HostileReference*> StorageType;
+
     private:
-        std::list<HostileReference*> iThreatList;
+        StorageType iThreatList;
         bool iDirty;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* hostileRef) { iThreatList.remove(hostileRef); }
+        void remove(HostileReference* hostileRef);
         void addReference(HostileReference* hostileRef) { iThreatList.push_back(hostileRef); }
         void clearReferences();
 
@@ -162,8 +166,8 @@ class ThreatContainer
 
         HostileReference* getReferenceByTarget(Unit* victim);
 
-        std::list<HostileReference*>& getThreatList() { return iThreatList; }
-        std::list<HostileReference*> GetThreatList() const { return iThreatList; }
+        StorageType& getThreatList() { return iThreatList; }
+        StorageType const& GetThreatList() const { return iThreatList; }
 };
 
 //=================================================
@@ -212,13 +216,13 @@ class ThreatManager
         // Reset all aggro of unit in threadlist satisfying the predicate.
         template<class PREDICATE> void resetAggro(PREDICATE predicate)
         {
-            std::list<HostileReference*> &threatList = getThreatList();
+            ThreatContainer::StorageType &threatList = getThreatList();
             if (threatList.empty())
                 return;
 
-            for (std::list<HostileReference*>::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+            for (uint32 i = 0; i < threatList.size(); ++i)
             {
-                HostileReference* ref = (*itr);
+                HostileReference* ref = threatList[i];
 
                 if (predicate(ref->getTarget()))
                 {
@@ -230,9 +234,9 @@ class ThreatManager
 
         // methods to access the lists from the outside to do some dirty manipulation (scriping and such)
         // I hope they are used as little as possible.
-        std::list<HostileReference*>& getThreatList() { return iThreatContainer.getThreatList(); }
-        std::list<HostileReference*> GetThreatList() const { return iThreatContainer.GetThreatList(); }
-        std::list<HostileReference*>& getOfflineThreatList() { return iThreatOfflineContainer.getThreatList(); }
+        ThreatContainer::StorageType& getThreatList() { return iThreatContainer.getThreatList(); }
+        ThreatContainer::StorageType const& GetThreatList() const { return iThreatContainer.GetThreatList(); }
+        ThreatContainer::StorageType& getOfflineThreatList() { return iThreatOfflineContainer.getThreatList(); }
         ThreatContainer& getOnlineContainer() { return iThreatContainer; }
         ThreatContainer& getOfflineContainer() { return iThreatOfflineContainer; }
 
@@ -2411,13 +2411,12 @@ bool GameObject::IsLootAllowedFor(Player const* p_Player) const
     return true;
 }
 
-void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
+void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, ViewerFieldList* viewerFields) const
 {
     if (!target)
         return;
 
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.usegrouplootrules && HasLootRecipient();
-    bool targetIsGM = target->isGameMaster();
     bool isStoppableTransport = GetGoType() == GAMEOBJECT_TYPE_TRANSPORT && !m_goValue->Transport.StopFrames->empty();
 
     ByteBuffer fieldBuffer;
@@ -2430,6 +2429,9 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
+    /// Offset in data of the first value, the block count and the mask come first
+    uint32 fieldsOffset = data->wpos() + 1 + ((m_valuesCount + UpdateMask::CLIENT_UPDATE_MASK_BITS - 1) / UpdateMask::CLIENT_UPDATE_MASK_BITS) * sizeof(UpdateMask::ClientUpdateMaskType);
+
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
         if (_fieldNotifyFlags & flags[index] ||
@@ -2438,45 +2440,13 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
         {
             updateMask.SetBit(index);
 
-            if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
+            uint32 viewerValue;
+            if (GetViewerDependentValue(index, target, viewerValue))
             {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
-                {
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    {
-                        float timer = float(m_goValue->Transport.PathProgress % GetTransportPeriod());
-                        pathProgress = int16(timer / float(GetTransportPeriod()) * 65535.0f);
-                        break;
-                    }
-                    case GAMEOBJECT_TYPE_MAP_OBJ_TRANSPORT:
-                        pathProgress = int16(float(m_goValue->Transport.PathProgress) / float(GetUInt32Value(GAMEOBJECT_FIELD_LEVEL)) * 65535.0f);
-                        break;
-                }
+                if (viewerFields)
+                    viewerFields->emplace_back(fieldsOffset + fieldBuffer.wpos(), index);
 
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
-            }
-            else if (index == GAMEOBJECT_FIELD_FLAGS)
-            {
-                uint32 flags = m_uint32Values[GAMEOBJECT_FIELD_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if ((GetGOInfo()->chest.usegrouplootrules || GetGOInfo()->GetTrackingQuestId()) && !IsLootAllowedFor(target))
-                        flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-
-                fieldBuffer << flags;
+                fieldBuffer << uint32(viewerValue);
             }
             else if (index == GAMEOBJECT_FIELD_LEVEL)
             {
@@ -2510,6 +2480,54 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     data->append(fieldBuffer);
 }
 
+bool GameObject::GetViewerDependentValue(uint16 index, Player* target, uint32& value) const
+{
+    if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
+    {
+        uint16 dynFlags = 0;
+        int16 pathProgress = -1;
+        switch (GetGoType())
+        {
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                else if (target->isGameMaster())
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_GENERIC:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                break;
+            case GAMEOBJECT_TYPE_TRANSPORT:
+            {
+                float timer = float(m_goValue->Transport.PathProgress % GetTransportPeriod());
+                pathProgress = int16(timer / float(GetTransportPeriod()) * 65535.0f);
+                break;
+            }
+            case GAMEOBJECT_TYPE_MAP_OBJ_TRANSPORT:
+                pathProgress = int16(float(m_goValue->Transport.PathProgress) / float(GetUInt32Value(GAMEOBJECT_FIELD_LEVEL)) * 65535.0f);
+                break;
+        }
+
+        /// Sent as uint16 dynamic flags followed by int16 path progress
+        value = uint32(dynFlags) | (uint32(uint16(pathProgress)) << 16);
+        return true;
+    }
+
+    if (index == GAMEOBJECT_FIELD_FLAGS)
+    {
+        value = m_uint32Values[GAMEOBJECT_FIELD_FLAGS];
+        if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+            if ((GetGOInfo()->chest.usegrouplootrules || GetGOInfo()->GetTrackingQuestId()) && !IsLootAllowedFor(target))
+                value |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+        return true;
+    }
+
+    return false;
+}
+
 void GameObject::GetRespawnPosition(float &x, float &y, float &z, float* ori /* = NULL*/) const
 {
     if (m_DBTableGuid)
@@ -935,7 +935,8 @@ class GameObject : public WorldObject, public GridObject<GameObject>, public Map
         explicit GameObject();
         ~GameObject();
 
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, ViewerFieldList* viewerFields = nullptr) const;
+        bool GetViewerDependentValue(uint16 index, Player* target, uint32& value) const;
 
         void AddToWorld();
         void RemoveFromWorld();
@@ -280,8 +280,47 @@ void Object::SendUpdateToPlayer(Player* player)
         player->GetSession()->SendPacket(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateBlockCache* cache) const
 {
+    if (cache)
+    {
+        uint32* flags = nullptr;
+        uint32 visibleFlags = GetUpdateFieldData(target, flags);
+        uint32 dynamicVisibleFlags = GetDynamicUpdateFieldData(target, flags);
+
+        for (ValuesUpdateBlockCache::Entry const& entry : cache->Entries)
+        {
+            if (entry.VisibleFlags != visibleFlags || entry.DynamicVisibleFlags != dynamicVisibleFlags)
+                continue;
+
+            data->AddUpdateBlock(entry.Block);
+
+            for (ViewerFieldList::value_type const& field : entry.ViewerFields)
+            {
+                uint32 value = 0;
+                GetViewerDependentValue(field.second, target, value);
+                data->PatchLastUpdateBlock(field.first, value);
+            }
+
+            return;
+        }
+
+        cache->Entries.emplace_back();
+
+        ValuesUpdateBlockCache::Entry& entry = cache->Entries.back();
+        entry.VisibleFlags = visibleFlags;
+        entry.DynamicVisibleFlags = dynamicVisibleFlags;
+
+        entry.Block << uint8(UPDATETYPE_VALUES);
+        entry.Block.append(GetPackGUID());
+
+        BuildValuesUpdate(UPDATETYPE_VALUES, &entry.Block, target, &entry.ViewerFields);
+        BuildDynamicValuesUpdate(UPDATETYPE_VALUES, &entry.Block, target);
+
+        data->AddUpdateBlock(entry.Block);
+        return;
+    }
+
     ByteBuffer buf(5 * 1024);
 
     buf << uint8(UPDATETYPE_VALUES);
@@ -841,7 +880,7 @@ void Object::BuildMovementUpdate(ByteBuffer* p_Data, uint32 p_Flags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
+void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, ViewerFieldList* /*viewerFields*/) const
 {
     if (!target)
         return;
@@ -853,9 +892,9 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32* flags = NULL;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
-    int sendedCount = 0;
+    uint32 sendedCount = 0;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    ForEachUpdateFieldCandidate(updateType, flags, _fieldNotifyFlags, -1, [&](uint16 index)
     {
         if (_fieldNotifyFlags & flags[index] ||
             ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
@@ -865,15 +904,9 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
             ++sendedCount;
         }
-    }
+    });
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (updateMask.GetBit(index))
-            --sendedCount;
-    }
-
-    ASSERT(sendedCount == 0);
+    ASSERT(updateMask.GetSetBitCount() == sendedCount);
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
@@ -938,7 +971,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateBlockCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -949,7 +982,7 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, cache);
 }
 
 void Object::_LoadIntoDataField(char const* p_Data, uint32 p_StartOffset, uint32 p_Count, bool p_Force)
@@ -3971,6 +4004,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     std::set<uint64> plr_list;
+    ValuesUpdateBlockCache i_blockCache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) {}
     void Visit(PlayerMapType &m)
     {
@@ -4028,7 +4062,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_blockCache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -4040,9 +4074,11 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
 {
     if (ToGameObject() && ToGameObject()->IsTransport())
     {
+        ValuesUpdateBlockCache blockCache;
+
         Map::PlayerList const& players = GetMap()->GetPlayers();
         for (Map::PlayerList::const_iterator itr = players.begin(); itr != players.end(); ++itr)
-            BuildFieldsUpdate(itr->getSource(), data_map);
+            BuildFieldsUpdate(itr->getSource(), data_map, &blockCache);
     }
     else
     {
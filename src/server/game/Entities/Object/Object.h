@@ -114,6 +114,24 @@ class Transport;
 typedef std::unordered_set<uint64> GuidUnorderedSet;
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+/// Offset in the update block and index of the fields whose value depends on the viewer
+typedef std::vector<std::pair<uint32, uint16>> ViewerFieldList;
+
+/// Values blocks of one object built during a single update, shared by the viewers of the same visibility class
+/// Only the viewer dependent fields (npc flags, dynamic flags, faction...) are computed again for each viewer
+struct ValuesUpdateBlockCache
+{
+    struct Entry
+    {
+        uint32 VisibleFlags;
+        uint32 DynamicVisibleFlags;
+        ByteBuffer Block;
+        ViewerFieldList ViewerFields;
+    };
+
+    std::vector<Entry> Entries;
+};
+
 class DynamicFields
 {
 public:
@@ -197,7 +215,7 @@ class Object
         virtual void BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target) const;
         void SendUpdateToPlayer(Player* player);
 
-        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateBlockCache* cache = nullptr) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
         virtual void DestroyForPlayer(Player* target, bool onDeath = false) const;
@@ -375,7 +393,7 @@ class Object
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateBlockCache* cache = nullptr) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -420,9 +438,42 @@ class Object
         uint32 GetDynamicUpdateFieldData(Player const* target, uint32*& flags) const;
 
         void BuildMovementUpdate(ByteBuffer * data, uint32 flags) const;
-        virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+        /// viewerFields receives the fields written with GetViewerDependentValue, to share the block with other viewers
+        virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, ViewerFieldList* viewerFields = nullptr) const;
+        /// Value of a field customized for the viewer, false if the stored value is sent to everyone
+        virtual bool GetViewerDependentValue(uint16 /*index*/, Player* /*target*/, uint32& /*value*/) const { return false; }
         virtual void BuildDynamicValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const;
 
+        /// Call p_Function for every field which may be part of the update, in ascending order
+        /// Values updates only visit the changed fields, the fields carrying p_ForcedFlags and p_ForcedIndex (-1 for none)
+        template<typename F> void ForEachUpdateFieldCandidate(uint8 p_UpdateType, uint32 const* p_Flags, uint32 p_ForcedFlags, int32 p_ForcedIndex, F p_Function) const
+        {
+            UpdateFieldFlagIndex const* l_FlagIndex = p_UpdateType == UPDATETYPE_VALUES ? GetUpdateFieldFlagIndex(p_Flags) : nullptr;
+            if (!l_FlagIndex)
+            {
+                for (uint16 l_Index = 0; l_Index < m_valuesCount; ++l_Index)
+                    p_Function(l_Index);
+
+                return;
+            }
+
+            for (uint32 l_Word = 0; l_Word < _changesMask.GetWordCount(); ++l_Word)
+            {
+                UpdateMask::WordType l_Candidates = _changesMask.GetWord(l_Word) | l_FlagIndex->GetWord(l_Word, p_ForcedFlags);
+                if (p_ForcedIndex >= 0 && uint32(p_ForcedIndex) / UpdateMask::WORD_BITS == l_Word)
+                    l_Candidates |= UpdateMask::WordType(1) << (p_ForcedIndex % UpdateMask::WORD_BITS);
+
+                for (; l_Candidates; l_Candidates &= l_Candidates - 1)
+                {
+                    uint32 l_Index = l_Word * UpdateMask::WORD_BITS + UpdateMask::CountTrailingZeros(l_Candidates);
+                    if (l_Index >= m_valuesCount)
+                        return;
+
+                    p_Function(uint16(l_Index));
+                }
+            }
+        }
+
         uint16 m_objectType;
 
         TypeID m_objectTypeId;
@@ -15,7 +15,7 @@
 #include "World.h"
 #include "zlib.h"
 
-UpdateData::UpdateData(uint16 map) : m_map(map), m_blockCount(0)
+UpdateData::UpdateData(uint16 map) : m_map(map), m_blockCount(0), m_lastBlockPos(0)
 {
 }
 
@@ -31,6 +31,7 @@ void UpdateData::AddOutOfRangeGUID(uint64 guid)
 
 void UpdateData::AddUpdateBlock(const ByteBuffer &block)
 {
+    m_lastBlockPos = m_data.wpos();
     m_data.append(block);
     ++m_blockCount;
 }
@@ -77,6 +78,7 @@ void UpdateData::Clear()
     m_data.clear();
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
+    m_lastBlockPos = 0;
     m_map = 0;
 }
 
@@ -47,13 +47,15 @@ class UpdateData
 {
     public:
         UpdateData(uint16 map);
-        UpdateData(UpdateData&& right) : m_map(right.m_map), m_blockCount(right.m_blockCount),
+        UpdateData(UpdateData&& right) : m_map(right.m_map), m_blockCount(right.m_blockCount), m_lastBlockPos(right.m_lastBlockPos),
             m_outOfRangeGUIDs(std::move(right.m_outOfRangeGUIDs)),
             m_data(std::move(right.m_data)) {}
 
         void AddOutOfRangeGUID(std::set<uint64>& guids);
         void AddOutOfRangeGUID(uint64 guid);
         void AddUpdateBlock(const ByteBuffer &block);
+        /// Overwrite a value of the last added block, used to customize a shared block for its viewer
+        void PatchLastUpdateBlock(uint32 offset, uint32 value) { m_data.put<uint32>(m_lastBlockPos + offset, value); }
         bool BuildPacket(WorldPacket* packet);
         bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
@@ -63,6 +65,7 @@ class UpdateData
     protected:
         uint16 m_map;
         uint32 m_blockCount;
+        size_t m_lastBlockPos;
         std::set<uint64> m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
@@ -8,6 +8,7 @@
 
 #include "Common.h"
 #include "UpdateFieldFlags.h"
+#include "UpdateMask.h"
 
 uint32 ContainerUpdateFieldFlags[CONTAINER_END]
 {
@@ -4057,3 +4058,34 @@ uint32 ConversationDynamicUpdateFieldFlags[CONVERSATION_DYNAMIC_END]
     UF_FLAG_PUBLIC, // CONVERSATION_DYNAMIC_FIELD_ACTORS
     UF_FLAG_VIEWER_DEPENDENT, // CONVERSATION_DYNAMIC_FIELD_LINES
 };
+
+UpdateFieldFlagIndex const* GetUpdateFieldFlagIndex(uint32 const* p_Flags)
+{
+    static UpdateFieldFlagIndex const s_ContainerIndex(ContainerUpdateFieldFlags, CONTAINER_END);
+    static UpdateFieldFlagIndex const s_PlayerIndex(PlayerUpdateFieldFlags, PLAYER_END);
+    static UpdateFieldFlagIndex const s_GameObjectIndex(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+    static UpdateFieldFlagIndex const s_DynamicObjectIndex(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+    static UpdateFieldFlagIndex const s_CorpseIndex(CorpseUpdateFieldFlags, CORPSE_END);
+    static UpdateFieldFlagIndex const s_AreaTriggerIndex(AreaTriggerUpdateFieldFlags, AREATRIGGER_END);
+    static UpdateFieldFlagIndex const s_SceneObjectIndex(SceneObjectUpdateFieldFlags, SCENEOBJECT_END);
+    static UpdateFieldFlagIndex const s_ConversationIndex(ConversationUpdateFieldFlags, CONVERSATION_END);
+
+    if (p_Flags == ContainerUpdateFieldFlags)
+        return &s_ContainerIndex;
+    if (p_Flags == PlayerUpdateFieldFlags)
+        return &s_PlayerIndex;
+    if (p_Flags == GameObjectUpdateFieldFlags)
+        return &s_GameObjectIndex;
+    if (p_Flags == DynamicObjectUpdateFieldFlags)
+        return &s_DynamicObjectIndex;
+    if (p_Flags == CorpseUpdateFieldFlags)
+        return &s_CorpseIndex;
+    if (p_Flags == AreaTriggerUpdateFieldFlags)
+        return &s_AreaTriggerIndex;
+    if (p_Flags == SceneObjectUpdateFieldFlags)
+        return &s_SceneObjectIndex;
+    if (p_Flags == ConversationUpdateFieldFlags)
+        return &s_ConversationIndex;
+
+    return nullptr;
+}
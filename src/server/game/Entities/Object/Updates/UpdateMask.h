@@ -13,24 +13,33 @@
 #include "Errors.h"
 #include "ByteBuffer.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// Packed bitset of the fields of an object, 64 fields per word
+/// Iteration walks the set bits only and skips the empty words
 class UpdateMask
 {
     public:
         /// Type representing how client reads update mask
         typedef uint32 ClientUpdateMaskType;
+        /// Storage word, two client blocks
+        typedef uint64 WordType;
 
         enum UpdateMaskCount
         {
             CLIENT_UPDATE_MASK_BITS = sizeof(ClientUpdateMaskType) * 8,
+            WORD_BITS               = sizeof(WordType) * 8,
         };
 
-        UpdateMask() : _fieldCount(0), _blockCount(0), _bits(nullptr) { }
+        UpdateMask() : _fieldCount(0), _blockCount(0), _wordCount(0), _bits(nullptr) { }
 
-        UpdateMask(UpdateMask const& right) : _bits(nullptr)
+        UpdateMask(UpdateMask const& right) : _fieldCount(0), _blockCount(0), _wordCount(0), _bits(nullptr)
         {
             SetCount(right.GetCount());
             if (right._bits)
-                memcpy(_bits, right._bits, sizeof (uint8) * _blockCount * 32);
+                memcpy(_bits, right._bits, sizeof (WordType) * _wordCount);
         }
 
         ~UpdateMask()
@@ -42,28 +51,56 @@ class UpdateMask
             }
         }
 
-        void SetBit(uint32 index) { _bits[index] = 1; }
-        void UnsetBit(uint32 index) { _bits[index] = 0; }
-        bool GetBit(uint32 index) const { return _bits[index] != 0; }
+        void SetBit(uint32 index) { _bits[index / WORD_BITS] |= WordType(1) << (index % WORD_BITS); }
+        void UnsetBit(uint32 index) { _bits[index / WORD_BITS] &= ~(WordType(1) << (index % WORD_BITS)); }
+        bool GetBit(uint32 index) const { return (_bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1; }
 
         void AppendToPacket(ByteBuffer* data)
         {
-            for (uint32 i = 0; i < GetBlockCount(); ++i)
-            {
-                ClientUpdateMaskType maskPart = 0;
-                for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                {
-                    if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                        maskPart |= 1 << j;
-                }
-
-                *data << maskPart;
-            }
+            if (!_blockCount)
+                return;
+
+#if TRINITY_ENDIAN == TRINITY_LITTLEENDIAN
+            /// Words are stored as consecutive little endian client blocks, the whole mask is a single copy
+            data->append(reinterpret_cast<uint8 const*>(_bits), _blockCount * sizeof(ClientUpdateMaskType));
+#else
+            for (uint32 i = 0; i < _blockCount; ++i)
+                *data << ClientUpdateMaskType(_bits[i / 2] >> ((i % 2) * CLIENT_UPDATE_MASK_BITS));
+#endif
         }
 
         uint32 GetBlockCount() const { return _blockCount; }
         uint32 GetCount() const { return _fieldCount; }
 
+        uint32 GetWordCount() const { return _wordCount; }
+        WordType GetWord(uint32 p_Index) const { return _bits[p_Index]; }
+
+        bool IsEmpty() const
+        {
+            for (uint32 i = 0; i < _wordCount; ++i)
+                if (_bits[i])
+                    return false;
+
+            return true;
+        }
+
+        uint32 GetSetBitCount() const
+        {
+            uint32 l_Count = 0;
+            for (uint32 i = 0; i < _wordCount; ++i)
+                l_Count += PopCount(_bits[i]);
+
+            return l_Count;
+        }
+
+        /// Call p_Function for every set bit, in ascending order
+        template<typename F> void ForEachSetBit(F p_Function) const
+        {
+            for (uint32 i = 0; i < _wordCount; ++i)
+                for (WordType l_Word = _bits[i]; l_Word; l_Word &= l_Word - 1)
+                    p_Function(i * WORD_BITS + CountTrailingZeros(l_Word));
+        }
+
         void SetCount(uint32 valuesCount)
         {
             if (_bits != nullptr)
@@ -74,33 +111,41 @@ class UpdateMask
 
             _fieldCount = valuesCount;
             _blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
+            _wordCount = (valuesCount + WORD_BITS - 1) / WORD_BITS;
 
             if (!valuesCount)
                 return;
 
-            _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-            memset(_bits, 0, sizeof (uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            _bits = new WordType[_wordCount];
+            memset(_bits, 0, sizeof (WordType) * _wordCount);
         }
 
         void AddBlock()
         {
-            uint8* curr = _bits;
             _fieldCount += CLIENT_UPDATE_MASK_BITS;
             ++_blockCount;
 
-            _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-            memset(&_bits[(_blockCount - 1) * CLIENT_UPDATE_MASK_BITS], 0, sizeof (uint8) * CLIENT_UPDATE_MASK_BITS);
+            /// Every other block fits in the upper half of the last word
+            uint32 l_WordCount = (_blockCount + 1) / 2;
+            if (l_WordCount == _wordCount)
+                return;
+
+            WordType* curr = _bits;
+            _bits = new WordType[l_WordCount];
+            memset(&_bits[_wordCount], 0, sizeof (WordType) * (l_WordCount - _wordCount));
             if (curr)
             {
-                memcpy(_bits, curr, sizeof (uint8) * (_blockCount - 1) * CLIENT_UPDATE_MASK_BITS);
+                memcpy(_bits, curr, sizeof (WordType) * _wordCount);
                 delete[] curr;
             }
+
+            _wordCount = l_WordCount;
         }
 
         void Clear()
         {
             if (_bits)
-                memset(_bits, 0, sizeof (uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+                memset(_bits, 0, sizeof (WordType) * _wordCount);
         }
 
         UpdateMask& operator=(UpdateMask const& right)
@@ -109,23 +154,28 @@ class UpdateMask
                 return *this;
 
             SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof (uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            if (right._bits)
+                memcpy(_bits, right._bits, sizeof (WordType) * _wordCount);
             return *this;
         }
 
         UpdateMask& operator&=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
+            for (uint32 i = 0; i < right._wordCount; ++i)
                 _bits[i] &= right._bits[i];
 
+            /// Fields the right mask doesn't know about are unset
+            for (uint32 i = right._wordCount; i < _wordCount; ++i)
+                _bits[i] = 0;
+
             return *this;
         }
 
         UpdateMask& operator|=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
+            for (uint32 i = 0; i < right._wordCount; ++i)
                 _bits[i] |= right._bits[i];
 
             return *this;
@@ -138,11 +188,74 @@ class UpdateMask
             return ret;
         }
 
+        static uint32 CountTrailingZeros(WordType p_Word)
+        {
+#if defined(_MSC_VER)
+            unsigned long l_Index;
+            _BitScanForward64(&l_Index, p_Word);
+            return l_Index;
+#else
+            return __builtin_ctzll(p_Word);
+#endif
+        }
+
+        static uint32 PopCount(WordType p_Word)
+        {
+#if defined(_MSC_VER)
+            return uint32(__popcnt64(p_Word));
+#else
+            return __builtin_popcountll(p_Word);
+#endif
+        }
+
     private:
         uint32 _fieldCount;
         uint32 _blockCount;
-        uint8* _bits;
+        uint32 _wordCount;
+        WordType* _bits;
 };
 
-#endif
+/// Fields of an update field flag table carrying each flag
+/// Values updates OR it with the changes mask to only visit the fields which may be sent
+class UpdateFieldFlagIndex
+{
+    public:
+        enum
+        {
+            FLAG_COUNT = 11     ///< UF_FLAG_PUBLIC to UF_FLAG_URGENT_SELF_ONLY
+        };
 
+        UpdateFieldFlagIndex(uint32 const* p_Flags, uint32 p_Count)
+        {
+            for (uint32 l_Flag = 0; l_Flag < FLAG_COUNT; ++l_Flag)
+            {
+                m_Masks[l_Flag].SetCount(p_Count);
+
+                for (uint32 l_Index = 0; l_Index < p_Count; ++l_Index)
+                    if (p_Flags[l_Index] & (1 << l_Flag))
+                        m_Masks[l_Flag].SetBit(l_Index);
+            }
+        }
+
+        /// Word p_Word of the fields carrying any of p_FlagMask
+        UpdateMask::WordType GetWord(uint32 p_Word, uint32 p_FlagMask) const
+        {
+            UpdateMask::WordType l_Result = 0;
+            for (; p_FlagMask; p_FlagMask &= p_FlagMask - 1)
+            {
+                uint32 l_Flag = UpdateMask::CountTrailingZeros(p_FlagMask);
+                if (l_Flag < FLAG_COUNT && p_Word < m_Masks[l_Flag].GetWordCount())
+                    l_Result |= m_Masks[l_Flag].GetWord(p_Word);
+            }
+
+            return l_Result;
+        }
+
+    private:
+        UpdateMask m_Masks[FLAG_COUNT];
+};
+
+/// Index of one of the update field flag tables, nullptr for unknown tables
+UpdateFieldFlagIndex const* GetUpdateFieldFlagIndex(uint32 const* p_Flags);
+
+#endif
@@ -321,6 +321,7 @@ Player::Player(WorldSession* session) : Unit(true), m_achievementMgr(this), m_re
     m_IsOutdoors = false;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_SaveDeferredTime = 0;
 
     _resurrectionData = NULL;
 
@@ -410,6 +411,12 @@ Player::Player(WorldSession* session) : Unit(true), m_achievementMgr(this), m_re
     m_nextMailDelivereTime = 0;
 
     m_itemUpdateQueueBlocked = false;
+    m_KnowledgeSnapshotDirty = true;
+    m_CurrencySnapshotDirty = true;
+
+    m_SaveSnapshots = std::make_shared<PlayerSaveSnapshots>();
+    m_SaveCounter   = 0;
+    memset(m_QueuedSaveSnapshots, 0, sizeof(m_QueuedSaveSnapshots));
 
     for (uint8 i = 0; i < MAX_MOVE_TYPE; ++i)
         m_forced_speed_changes[i] = 0;
@@ -1528,6 +1535,8 @@ void Player::Update(uint32 p_time)
     if (!IsInWorld())
         return;
 
+    RefreshKnowledgeSnapshot();
+
     if (!m_initializeCallback)
     {
         PreparedStatement* stmt;
@@ -1535,7 +1544,7 @@ void Player::Update(uint32 p_time)
         stmt = RealmDatabase.GetPreparedStatement(CHAR_SEL_CHAR_PET_BY_ENTRY_AND_SLOT);
         stmt->setUInt32(0, GetRealGUIDLow());
         stmt->setUInt32(1, m_currentPetSlot);
-        _petPreloadCallback = RealmDatabase.AsyncQuery(stmt);
+        _petPreloadCallback = RealmDatabase.AsyncQuery(stmt, GetRealGUIDLow());
 
         m_initializeCallback = true;
     }
@@ -1920,7 +1929,13 @@ void Player::Update(uint32 p_time)
 
     if (m_nextSave > 0)
     {
-        if (p_time >= m_nextSave)
+        /// Database workers can't keep up, spread the retries, but never delay a save by more than one save interval
+        if (p_time >= m_nextSave && RealmDatabase.IsBackPressured() && m_SaveDeferredTime < sWorld->getIntConfig(CONFIG_INTERVAL_SAVE))
+        {
+            m_nextSave = urand(1 * IN_MILLISECONDS, 10 * IN_MILLISECONDS);
+            m_SaveDeferredTime += m_nextSave;
+        }
+        else if (p_time >= m_nextSave)
         {
             // m_nextSave reseted in SaveToDB call
             SaveToDB();
@@ -4301,7 +4316,7 @@ void Player::GiveLevel(uint8 level)
     if (MailLevelReward const* mailReward = sObjectMgr->GetMailLevelReward(level, getRaceMask()))
     {
         //- @TODO: Poor design of mail system
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        SQLTransaction trans = CharacterDatabase.BeginTransaction(GetRealGUIDLow());
         MailDraft(mailReward->mailTemplateId).SendMailTo(trans, this, MailSender(MAIL_CREATURE, mailReward->senderEntry));
         CharacterDatabase.CommitTransaction(trans);
     }
@@ -4873,6 +4888,8 @@ bool Player::AddTalent(uint32 spellId, uint8 spec, bool learning)
 
 bool Player::addSpell(uint32 spellId, bool active, bool learning, bool dependent, bool disabled, bool loading /*= false*/, bool p_IsMountFavorite, bool p_LearnBattlePet, bool p_FromShopItem)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
     if (!spellInfo)
         return false;
@@ -5312,6 +5329,8 @@ bool Player::addSpell(uint32 spellId, bool active, bool learning, bool dependent
 
 void Player::AddTemporarySpell(uint32 spellId)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     PlayerSpellMap::iterator itr = m_spells.find(spellId);
     // spell already added - do not do anything
     if (itr != m_spells.end())
@@ -5326,6 +5345,8 @@ void Player::AddTemporarySpell(uint32 spellId)
 
 void Player::RemoveTemporarySpell(uint32 spellId)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     PlayerSpellMap::iterator itr = m_spells.find(spellId);
     // spell already not in list - do not do anything
     if (itr == m_spells.end())
@@ -5400,6 +5421,8 @@ void Player::learnSpell(uint32 p_SpellId, bool dependent, bool p_FromItemShop)
 
 void Player::removeSpell(uint32 spell_id, bool disabled, bool learn_low_rank)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     PlayerSpellMap::iterator itr = m_spells.find(spell_id);
     if (itr == m_spells.end())
         return;
@@ -6046,7 +6069,7 @@ bool Player::ResetTalents(bool p_NoCost /*= false*/)
     auto l_Database = &CharacterDatabase;
 #endif
 
-    SQLTransaction charTrans = l_Database->BeginTransaction();
+    SQLTransaction charTrans = l_Database->BeginTransaction(GetRealGUIDLow());
     SQLTransaction accountTrans = LoginDatabase.BeginTransaction();
     _SaveTalents(charTrans);
     _SaveSpells(charTrans, accountTrans);
@@ -6472,6 +6495,62 @@ bool Player::HasSpell(uint32 spell) const
         !itr->second->disabled);
 }
 
+void Player::UpdateKnowledgeSnapshot()
+{
+    PlayerKnowledgeSnapshotPtr l_Previous = std::atomic_load(&m_KnowledgeSnapshot);
+    std::shared_ptr<PlayerKnowledgeSnapshot> l_Snapshot = std::make_shared<PlayerKnowledgeSnapshot>();
+
+    /// Currencies change far more often than spells, the unchanged parts are copied from the previous snapshot
+    if (m_KnowledgeSnapshotDirty || !l_Previous)
+    {
+        l_Snapshot->Spells.reserve(m_spells.size());
+        for (PlayerSpellMap::const_iterator l_Itr = m_spells.begin(); l_Itr != m_spells.end(); ++l_Itr)
+        {
+            if (l_Itr->second->state != PLAYERSPELL_REMOVED && !l_Itr->second->disabled)
+                l_Snapshot->Spells.push_back(l_Itr->first);
+        }
+
+        l_Snapshot->Skills.reserve(mSkillStatus.size());
+        for (SkillStatusMap::const_iterator l_Itr = mSkillStatus.begin(); l_Itr != mSkillStatus.end(); ++l_Itr)
+        {
+            if (l_Itr->second.uState == SKILL_DELETED)
+                continue;
+
+            PlayerKnowledgeSnapshot::Skill l_Skill = { l_Itr->first, GetSkillValue(l_Itr->first), GetSkillStep(l_Itr->first), GetBaseSkillValue(l_Itr->first), GetPureMaxSkillValue(l_Itr->first) };
+            l_Snapshot->Skills.push_back(l_Skill);
+        }
+
+        std::sort(l_Snapshot->Spells.begin(), l_Snapshot->Spells.end());
+        std::sort(l_Snapshot->Skills.begin(), l_Snapshot->Skills.end());
+    }
+    else
+    {
+        l_Snapshot->Spells = l_Previous->Spells;
+        l_Snapshot->Skills = l_Previous->Skills;
+    }
+
+    if (m_CurrencySnapshotDirty || !l_Previous)
+    {
+        l_Snapshot->Currencies.reserve(_currencyStorage.size());
+        for (PlayerCurrenciesMap::const_iterator l_Itr = _currencyStorage.begin(); l_Itr != _currencyStorage.end(); ++l_Itr)
+        {
+            CurrencyTypesEntry const* l_Currency = sCurrencyTypesStore.LookupEntry(l_Itr->first);
+            uint32 l_Precision = (l_Currency && l_Currency->Flags & CURRENCY_FLAG_HIGH_PRECISION) ? CURRENCY_PRECISION : 1;
+
+            PlayerKnowledgeSnapshot::Currency l_Entry = { l_Itr->first, l_Itr->second.totalCount, l_Precision };
+            l_Snapshot->Currencies.push_back(l_Entry);
+        }
+
+        std::sort(l_Snapshot->Currencies.begin(), l_Snapshot->Currencies.end());
+    }
+    else
+        l_Snapshot->Currencies = l_Previous->Currencies;
+
+    std::atomic_store(&m_KnowledgeSnapshot, PlayerKnowledgeSnapshotPtr(l_Snapshot));
+    m_KnowledgeSnapshotDirty = false;
+    m_CurrencySnapshotDirty = false;
+}
+
 bool Player::HasTalent(uint32 spell, uint8 spec) const
 {
     PlayerTalentMap::const_iterator itr = GetTalentMap(spec)->find(spell);
@@ -6607,7 +6686,7 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
         // Completely remove from the database
         case CHAR_DELETE_REMOVE:
         {
-            SQLTransaction trans = CharacterDatabase.BeginTransaction();
+            SQLTransaction trans = CharacterDatabase.BeginTransaction(guid);
 
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_COD_ITEM_MAIL);
             stmt->setUInt32(0, guid);
@@ -6875,7 +6954,7 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
 
             stmt->setUInt32(0, guid);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, guid);
             break;
         }
         default:
@@ -8044,6 +8123,8 @@ void Player::SetRegularAttackTime()
 //skill+step, checking for max value
 bool Player::UpdateSkill(uint32 skill_id, uint32 step)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     if (!skill_id)
         return false;
 
@@ -8186,6 +8267,8 @@ static const size_t g_BonusSkillLevelsSize = sizeof(g_BonusSkillLevels) / sizeof
 
 bool Player::UpdateSkillPro(uint16 p_SkillId, int32 p_Chance, uint32 p_Step)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     sLog->outDebug(LOG_FILTER_PLAYER_SKILLS, "UpdateSkillPro(SkillId %d, Chance %3.1f%%)", p_SkillId, p_Chance / 10.0f);
 
     if (!p_SkillId)
@@ -8247,6 +8330,8 @@ bool Player::UpdateSkillPro(uint16 p_SkillId, int32 p_Chance, uint32 p_Step)
 
 void Player::ModifySkillBonus(uint32 skillid, int32 val, bool talent)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     SkillStatusMap::const_iterator itr = mSkillStatus.find(skillid);
     if (itr == mSkillStatus.end() || itr->second.uState == SKILL_DELETED)
         return;
@@ -8263,6 +8348,8 @@ void Player::ModifySkillBonus(uint32 skillid, int32 val, bool talent)
 // To "remove" a skill line, set it's values to zero
 void Player::SetSkill(uint16 id, uint16 step, uint16 newVal, uint16 maxVal)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     if (!id)
         return;
 
@@ -9557,6 +9644,8 @@ void Player::_LoadCurrency(PreparedQueryResult result)
 
     }
     while (result->NextRow());
+
+    m_CurrencySnapshotDirty = true;
 }
 
 void Player::_SaveCurrency(SQLTransaction& trans)
@@ -9868,6 +9957,7 @@ int32 Player::ModifyCurrency(uint32 p_CurrencyID, int32 p_Count, bool p_Suppress
         l_CurrencyIT->second.totalCount = l_NewTotalCount;
         l_CurrencyIT->second.weekCount = l_NewWeekCount;
         l_CurrencyIT->second.seasonTotal = l_NewSeasonTotalCount;
+        m_CurrencySnapshotDirty = true;
 
         // probably excessive checks
         if (IsInWorld() && !GetSession()->PlayerLoading())
@@ -10088,7 +10178,7 @@ uint32 Player::GetZoneIdFromDB(uint64 guid)
             stmt->setUInt16(0, uint16(zone));
             stmt->setUInt32(1, guidLow);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
         }
     }
 #endif
@@ -15483,7 +15573,7 @@ Item* Player::StoreNewItem(ItemPosCountVec const& dest, uint32 item, bool update
             PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_ITEM_BOP_TRADE);
             stmt->setUInt32(0, pItem->GetRealGUIDLow());
             stmt->setString(1, ss.str());
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
         }
     }
     return pItem;
@@ -16048,7 +16138,7 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
         {
             PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_GIFT);
             stmt->setUInt32(0, pItem->GetRealGUIDLow());
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
         }
 
         RemoveEnchantmentDurations(pItem);
@@ -19192,7 +19282,7 @@ void Player::RewardQuest(Quest const* p_Quest, uint32 p_Reward, Object* p_QuestG
     if (uint32 mail_template_id = p_Quest->GetRewMailTemplateId())
     {
         //- TODO: Poor design of mail system
-        SQLTransaction trans = CharacterDatabase.BeginTransaction();
+        SQLTransaction trans = CharacterDatabase.BeginTransaction(GetRealGUIDLow());
         MailDraft(mail_template_id).SendMailTo(trans, this, p_QuestGiver, MAIL_CHECK_MASK_HAS_BODY, p_Quest->GetRewMailDelaySecs());
         CharacterDatabase.CommitTransaction(trans);
     }
@@ -20977,7 +21067,7 @@ void Player::SetHomebind(WorldLocation const& loc, uint32 area_id)
     stmt->setFloat (3, m_homebindY);
     stmt->setFloat (4, m_homebindZ);
     stmt->setUInt32(5, GetRealGUIDLow());
-    RealmDatabase.Execute(stmt);
+    RealmDatabase.Execute(stmt, GetRealGUIDLow());
 }
 
 uint32 Player::GetUInt32ValueFromArray(Tokenizer const& data, uint16 index)
@@ -21113,7 +21203,7 @@ bool Player::LoadFromDB(uint32 guid, SQLQueryHolder* holder, SQLQueryHolder* p_L
         stmt->setUInt16(0, uint16(AT_LOGIN_RENAME));
         stmt->setUInt32(1, guid);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetRealGUIDLow());
 
         return false;
     }
@@ -22229,7 +22319,7 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
         std::map<uint32, Bag*> bagMap;                                  // fast guid lookup for bags
         std::map<uint32, Item*> invalidBagMap;                          // fast guid lookup for bags
         std::list<Item*> problematicItems;
-        SQLTransaction trans = l_Database->BeginTransaction();
+        SQLTransaction trans = l_Database->BeginTransaction(GetRealGUIDLow());
 
         // Prevent items from being added to the queue while loading
         m_itemUpdateQueueBlocked = true;
@@ -22486,7 +22576,7 @@ Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, F
                                 l_Player->GetGUIDLow(), l_Player->GetName(), l_ItemRetreive->GetGUIDLow(), l_ItemRetreive->GetEntry());
                             l_ItemRetreive->RemoveFlag(ITEM_FIELD_DYNAMIC_FLAGS, ITEM_FIELD_FLAG_REFUNDABLE);
                         }
-                    });
+                    }, GetRealGUIDLow());
                 }
             }
             else if (item->HasFlag(ITEM_FIELD_DYNAMIC_FLAGS, ITEM_FIELD_FLAG_BOP_TRADEABLE))
@@ -22522,7 +22612,7 @@ Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, F
                             l_Player->GetGUIDLow(), l_Player->GetName(), l_ItemRetreive->GetGUIDLow(), l_ItemRetreive->GetEntry());
                         l_ItemRetreive->RemoveFlag(ITEM_FIELD_DYNAMIC_FLAGS, ITEM_FIELD_FLAG_BOP_TRADEABLE);
                     }
-                });
+                }, GetRealGUIDLow());
             }
             else if (proto->HolidayId)
             {
@@ -22591,11 +22681,11 @@ void Player::_LoadMailedItems(PreparedQueryResult p_MailedItems)
 
             PreparedStatement* l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INVALID_MAIL_ITEM);
             l_Statement->setUInt32(0, l_ItemGuid);
-            CharacterDatabase.Execute(l_Statement);
+            CharacterDatabase.Execute(l_Statement, GetRealGUIDLow());
 
             l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
             l_Statement->setUInt32(0, l_ItemGuid);
-            CharacterDatabase.Execute(l_Statement);
+            CharacterDatabase.Execute(l_Statement, GetRealGUIDLow());
             continue;
         }
 
@@ -22606,7 +22696,7 @@ void Player::_LoadMailedItems(PreparedQueryResult p_MailedItems)
 
             PreparedStatement* l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM);
             l_Statement->setUInt32(0, l_ItemGuid);
-            CharacterDatabase.Execute(l_Statement);
+            CharacterDatabase.Execute(l_Statement, GetRealGUIDLow());
 
             l_Item->FSetState(ITEM_REMOVED);
 
@@ -22694,7 +22784,7 @@ void Player::LoadPet(PreparedQueryResult result)
             return;
         }
 
-        _petLoginCallback = RealmDatabase.DelayQueryHolder((SQLQueryHolder*)queryHolder);
+        _petLoginCallback = RealmDatabase.DelayQueryHolder((SQLQueryHolder*)queryHolder, GetRealGUIDLow());
     }
 }
 
@@ -23170,7 +23260,7 @@ void Player::_LoadBoundInstances(PreparedQueryResult result)
                 stmt->setUInt32(0, GetGUIDLow());
                 stmt->setUInt32(1, instanceId);
 
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.Execute(stmt, GetRealGUIDLow());
 
                 continue;
             }
@@ -23239,7 +23329,7 @@ void Player::UnbindInstance(BoundInstancesMap::iterator &itr, Difficulty difficu
             PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_INSTANCE_BY_INSTANCE_GUID);
             stmt->setUInt32(0, GetRealGUIDLow());
             stmt->setUInt32(1, itr->second.save->GetInstanceId());
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
         }
 
 #ifndef CROSS
@@ -23269,7 +23359,7 @@ InstancePlayerBind* Player::BindToInstance(InstanceSave* p_InstanceSave, bool p_
                     l_Statement->setBool(1, p_Permanent);
                     l_Statement->setUInt32(2, GetRealGUIDLow());
                     l_Statement->setUInt32(3, l_InstanceBind.save->GetInstanceId());
-                    RealmDatabase.Execute(l_Statement);
+                    RealmDatabase.Execute(l_Statement, GetRealGUIDLow());
                 }
             }
         }
@@ -23281,7 +23371,7 @@ InstancePlayerBind* Player::BindToInstance(InstanceSave* p_InstanceSave, bool p_
                 l_Statement->setUInt32(0, GetRealGUIDLow());
                 l_Statement->setUInt32(1, p_InstanceSave->GetInstanceId());
                 l_Statement->setBool(2, p_Permanent);
-                RealmDatabase.Execute(l_Statement);
+                RealmDatabase.Execute(l_Statement, GetRealGUIDLow());
             }
         }
 
@@ -23565,7 +23655,7 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
         {
             PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_HOMEBIND);
             stmt->setUInt32(0, GetRealGUIDLow());
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
         }
     }
 
@@ -23584,7 +23674,7 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
         stmt->setFloat (3, m_homebindX);
         stmt->setFloat (4, m_homebindY);
         stmt->setFloat (5, m_homebindZ);
-        RealmDatabase.Execute(stmt);
+        RealmDatabase.Execute(stmt, GetRealGUIDLow());
     }
 
     sLog->outDebug(LOG_FILTER_PLAYER, "Setting player home position - mapid: %u, areaid: %u, X: %f, Y: %f, Z: %f",
@@ -23605,6 +23695,7 @@ void Player::SaveToDB(bool create /*=false*/, MS::Utilities::CallBackPtr p_Callb
 
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_SaveDeferredTime = 0;
 
 #ifndef CROSS
     if (GetSession()->GetInterRealmBG())
@@ -23927,6 +24018,13 @@ void Player::SaveToDB(bool create /*=false*/, MS::Utilities::CallBackPtr p_Callb
     SQLTransaction trans = RealmDatabase.BeginTransaction();
     SQLTransaction accountTrans = LoginDatabase.BeginTransaction();
 
+    m_PendingSaveSnapshots.clear();
+    ++m_SaveCounter;
+
+    /// Saves of the same character must never overtake each other on the worker queues
+    trans->SetOrderingKey(GetRealGUIDLow());
+    accountTrans->SetOrderingKey(GetSession()->GetAccountId());
+
     trans->Append(stmt);
 
 #ifndef CROSS
@@ -23980,6 +24078,38 @@ void Player::SaveToDB(bool create /*=false*/, MS::Utilities::CallBackPtr p_Callb
         l_Pet->Save(accountTrans);
     }
 
+    if (!m_PendingSaveSnapshots.empty())
+    {
+        std::shared_ptr<PlayerSaveSnapshots> l_Snapshots = m_SaveSnapshots;
+        std::shared_ptr<std::vector<std::pair<PlayerSaveSnapshot, std::string>>> l_Pending = std::make_shared<std::vector<std::pair<PlayerSaveSnapshot, std::string>>>();
+        l_Pending->swap(m_PendingSaveSnapshots);
+
+        uint32 l_SaveId = m_SaveCounter;
+        MS::Utilities::CallBackPtr l_UserCallback = p_Callback;
+
+        /// A failed save leaves the committed contents untouched, so the next save rewrites these collections
+        p_Callback = std::make_shared<MS::Utilities::Callback>([l_Snapshots, l_Pending, l_SaveId, l_UserCallback](bool p_Success) -> void
+        {
+            if (p_Success)
+            {
+                std::lock_guard<std::mutex> l_Guard(l_Snapshots->Lock);
+
+                /// Transaction callbacks aren't run in commit order, an older save must not replace the content of a newer one
+                for (auto const& l_Snapshot : *l_Pending)
+                {
+                    if (l_SaveId <= l_Snapshots->CommittedSave[l_Snapshot.first])
+                        continue;
+
+                    l_Snapshots->CommittedSave[l_Snapshot.first] = l_SaveId;
+                    l_Snapshots->Committed[l_Snapshot.first]     = l_Snapshot.second;
+                }
+            }
+
+            if (l_UserCallback != nullptr)
+                l_UserCallback->m_CallBack(p_Success);
+        });
+    }
+
     RealmDatabase.CommitTransaction(trans, p_Callback);
     LoginDatabase.CommitTransaction(accountTrans);
 
@@ -24056,8 +24186,67 @@ void Player::_SaveActions(SQLTransaction& trans)
     }
 }
 
+bool Player::UpdateSaveSnapshot(PlayerSaveSnapshot p_Collection, ByteBuffer const& p_Content, bool p_Force /*= false*/)
+{
+    if (!p_Force)
+    {
+        std::lock_guard<std::mutex> l_Guard(m_SaveSnapshots->Lock);
+        std::string const& l_Saved = m_SaveSnapshots->Committed[p_Collection];
+
+        /// A save still in flight or failed may have written another content, the collection is rewritten until it is committed
+        /// Contents always start with their row count, so they are never empty and never match a collection not saved yet
+        if (m_SaveSnapshots->CommittedSave[p_Collection] == m_QueuedSaveSnapshots[p_Collection]
+            && l_Saved.size() == p_Content.size() && !memcmp(l_Saved.data(), p_Content.contents(), l_Saved.size()))
+            return false;
+    }
+
+    /// Only becomes the reference content once the transaction is committed, see SaveToDB
+    m_PendingSaveSnapshots.emplace_back(p_Collection, std::string(reinterpret_cast<char const*>(p_Content.contents()), p_Content.size()));
+    m_QueuedSaveSnapshots[p_Collection] = m_SaveCounter;
+    return true;
+}
+
 void Player::_SaveAuras(SQLTransaction& trans)
 {
+    /// Most characters keep the same auras between two autosaves, only rewrite them if a row would change
+    ByteBuffer l_Content(256);
+    l_Content << uint32(0);
+
+    uint32 l_Count = 0;
+
+    for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
+    {
+        Aura* aura = itr->second;
+        if (!aura->CanBeSaved())
+            continue;
+
+        AuraApplication* foundAura = GetAuraApplication(aura->GetId(), aura->GetCasterGUID(), aura->GetCastItemGUID());
+        if (!foundAura)
+            continue;
+
+        ++l_Count;
+        l_Content << uint8(foundAura->GetSlot()) << uint64(aura->GetCasterGUID()) << uint64(aura->GetCastItemGUID()) << uint32(aura->GetId());
+
+        /// The remaining duration changes at every update, the expiration time only when the aura is refreshed
+        int32 l_Duration = aura->GetDuration();
+        int32 l_Expiration = l_Duration > 0 ? int32((uint32(time(NULL)) + l_Duration / IN_MILLISECONDS) / MINUTE) : l_Duration;
+
+        l_Content << uint8(aura->GetStackAmount()) << int32(aura->GetMaxDuration()) << int32(l_Expiration) << uint8(aura->GetCharges());
+        l_Content << int32(aura->GetCastItemLevel());
+
+        for (uint8 i = 0; i < aura->GetEffectCount(); ++i)
+        {
+            if (AuraEffect const* effect = aura->GetEffect(i))
+                l_Content << uint8(i) << int32(effect->GetBaseAmount()) << int32(effect->GetAmount()) << uint8(effect->CanBeRecalculated());
+        }
+    }
+
+    l_Content.put<uint32>(0, l_Count);
+
+    /// The rows hold the remaining duration, which must be exact when the character logs out
+    if (!UpdateSaveSnapshot(PLAYER_SAVE_SNAPSHOT_AURAS, l_Content, m_session->isLogingOut()))
+        return;
+
     PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
     stmt->setUInt32(0, GetRealGUIDLow());
     trans->Append(stmt);
@@ -24065,6 +24254,9 @@ void Player::_SaveAuras(SQLTransaction& trans)
     stmt->setUInt32(0, GetRealGUIDLow());
     trans->Append(stmt);
 
+    /// Effect rows are appended after the aura rows, so each table is written by a single multi-row insert
+    std::vector<PreparedStatement*> l_EffectStatements;
+
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
         if (!itr->second->CanBeSaved())
@@ -24094,7 +24286,7 @@ void Player::_SaveAuras(SQLTransaction& trans)
                 stmt->setInt32(index++, effect->GetBaseAmount());
                 stmt->setInt32(index++, effect->GetAmount());
 
-                trans->Append(stmt);
+                l_EffectStatements.push_back(stmt);
 
                 baseDamage[i] = effect->GetBaseAmount();
                 damage[i] = effect->GetAmount();
@@ -24125,6 +24317,9 @@ void Player::_SaveAuras(SQLTransaction& trans)
         stmt->setInt32(index++, aura->GetCastItemLevel());
         trans->Append(stmt);
     }
+
+    for (PreparedStatement* l_Statement : l_EffectStatements)
+        trans->Append(l_Statement);
 }
 
 void Player::_SaveInventory(SQLTransaction& trans)
@@ -24353,7 +24548,7 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
 {
     bool isTransaction = trans.get() != nullptr;
     if (!isTransaction)
-        trans = RealmDatabase.BeginTransaction();
+        trans = RealmDatabase.BeginTransaction(GetRealGUIDLow());
 
     QuestStatusSaveMap::iterator saveItr;
     QuestStatusMap::iterator statusItr;
@@ -24715,15 +24910,30 @@ void Player::_SaveStats(SQLTransaction& trans)
     if (!sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE) || getLevel() < sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE))
         return;
 
-    PreparedStatement* stmt = NULL;
+    /// The row is replaced as a whole, skip it while none of its values changed
+    ByteBuffer l_Content(256);
+    l_Content << uint32(1) << uint32(GetMaxHealth());
 
-    stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
-    stmt->setUInt32(0, GetRealGUIDLow());
-    trans->Append(stmt);
+    for (uint8 i = 0; i < MAX_POWERS_PER_CLASS; ++i)
+        l_Content << uint32(GetMaxPower(Powers(i)));
+
+    for (uint8 i = 0; i < MAX_STATS; ++i)
+        l_Content << uint32(GetStat(Stats(i)));
+
+    for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
+        l_Content << uint32(GetResistance(SpellSchools(i)));
+
+    l_Content << GetFloatValue(PLAYER_FIELD_BLOCK_PERCENTAGE) << GetFloatValue(PLAYER_FIELD_DODGE_PERCENTAGE) << GetFloatValue(PLAYER_FIELD_PARRY_PERCENTAGE);
+    l_Content << GetFloatValue(PLAYER_FIELD_CRIT_PERCENTAGE) << GetFloatValue(PLAYER_FIELD_RANGED_CRIT_PERCENTAGE) << GetFloatValue(PLAYER_FIELD_SPELL_CRIT_PERCENTAGE);
+    l_Content << GetUInt32Value(UNIT_FIELD_ATTACK_POWER) << GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER) << uint32(GetBaseSpellPowerBonus());
+    l_Content << GetUInt32Value(PLAYER_FIELD_COMBAT_RATINGS + CR_RESILIENCE_PLAYER_DAMAGE_TAKEN);
+
+    if (!UpdateSaveSnapshot(PLAYER_SAVE_SNAPSHOT_STATS, l_Content))
+        return;
 
     uint8 index = 0;
 
-    stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_CHAR_STATS);
+    PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_REP_CHAR_STATS);
     stmt->setUInt32(index++, GetRealGUIDLow());
     stmt->setUInt32(index++, GetMaxHealth());
 
@@ -24758,11 +24968,22 @@ void Player::_SaveCharacterGarrisonDailyTavernDatas(SQLTransaction& p_Transactio
     if (l_GarrisonMgr == nullptr)
         return;
 
+    std::vector<uint32> const& l_TavernDatas = l_GarrisonMgr->GetGarrisonDailyTavernDatas();
+
+    ByteBuffer l_Content(64);
+    l_Content << uint32(l_TavernDatas.size());
+
+    for (uint32 l_TavernData : l_TavernDatas)
+        l_Content << uint32(l_TavernData);
+
+    if (!UpdateSaveSnapshot(PLAYER_SAVE_SNAPSHOT_DAILY_TAVERN, l_Content))
+        return;
+
     PreparedStatement* l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GARRISON_DAILY_TAVERN_DATA_CHAR);
     l_Stmt->setUInt32(0, GetGUIDLow());
     p_Transaction->Append(l_Stmt);
 
-    for (uint32 l_TavernData : l_GarrisonMgr->GetGarrisonDailyTavernDatas())
+    for (uint32 l_TavernData : l_TavernDatas)
     {
         l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_GARRISON_DAILY_TAVERN_DATA_CHAR);
         l_Stmt->setUInt32(0, GetGUIDLow());
@@ -24778,11 +24999,27 @@ void Player::_SaveCharacterGarrisonWeeklyTavernDatas(SQLTransaction& p_Transacti
     if (l_GarrisonMgr == nullptr)
         return;
 
+    std::vector<MS::Garrison::WeeklyTavernData> const& l_TavernDatas = l_GarrisonMgr->GetGarrisonWeeklyTavernDatas();
+
+    ByteBuffer l_Content(128);
+    l_Content << uint32(l_TavernDatas.size());
+
+    for (MS::Garrison::WeeklyTavernData const& l_TavernData : l_TavernDatas)
+    {
+        l_Content << uint32(l_TavernData.FollowerID) << uint32(l_TavernData.Abilities.size());
+
+        for (uint32 l_Ability : l_TavernData.Abilities)
+            l_Content << uint32(l_Ability);
+    }
+
+    if (!UpdateSaveSnapshot(PLAYER_SAVE_SNAPSHOT_WEEKLY_TAVERN, l_Content))
+        return;
+
     PreparedStatement* l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GARRISON_WEEKLY_TAVERN_DATA_CHAR);
     l_Stmt->setUInt32(0, GetGUIDLow());
     p_Transaction->Append(l_Stmt);
 
-    for (MS::Garrison::WeeklyTavernData l_TavernData : l_GarrisonMgr->GetGarrisonWeeklyTavernDatas())
+    for (MS::Garrison::WeeklyTavernData const& l_TavernData : l_TavernDatas)
     {
         l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_GARRISON_WEEKLY_TAVERN_DATA_CHAR);
         l_Stmt->setUInt32(0, GetGUIDLow());
@@ -24901,7 +25138,7 @@ void Player::SavePositionInDB(uint32 mapid, float x, float y, float z, float o,
     stmt->setUInt16(5, uint16(zone));
     stmt->setUInt32(6, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
 #endif
 }
 
@@ -24938,7 +25175,7 @@ void Player::Customize(uint64 guid, uint8 gender, uint8 skin, uint8 face, uint8
     stmt->setUInt32(2, playerBytes2);
     stmt->setUInt32(3, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
 #endif
 }
 
@@ -26033,7 +26270,7 @@ void Player::RemovePetitionsAndSigns(uint64 guid, uint32 type)
 
             stmt->setUInt32(0, GUID_LOPART(guid));
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
         }
         else
         {
@@ -26042,11 +26279,11 @@ void Player::RemovePetitionsAndSigns(uint64 guid, uint32 type)
             stmt->setUInt32(0, GUID_LOPART(guid));
             stmt->setUInt8(1, uint8(type));
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
         }
     }
 
-    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    SQLTransaction trans = CharacterDatabase.BeginTransaction(GUID_LOPART(guid));
     if (type == 10)
     {
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PETITION_BY_OWNER);
@@ -29121,7 +29358,7 @@ void Player::AutoUnequipOffhandIfNeed(bool force /*= false*/)
     else
     {
         MoveItemFromInventory(INVENTORY_SLOT_BAG_0, EQUIPMENT_SLOT_OFFHAND, true);
-        SQLTransaction trans = RealmDatabase.BeginTransaction();
+        SQLTransaction trans = RealmDatabase.BeginTransaction(GetRealGUIDLow());
         offItem->DeleteFromInventoryDB(trans);                   // deletes item from character's inventory
         offItem->SaveToDB(trans);                                // recursive and not have transaction guard into self, item not in inventory and can be save standalone
 
@@ -30731,6 +30968,8 @@ void Player::learnSpellHighRank(uint32 spellid)
 
 void Player::_LoadSkills(PreparedQueryResult result)
 {
+    m_KnowledgeSnapshotDirty = true;
+
     //                                                           0      1      2
     // SetPQuery(PLAYER_LOGIN_QUERY_LOADSKILLS,          "SELECT skill, value, max FROM character_skills WHERE guid = '%u'", GUID_LOPART(m_guid));
 
@@ -30774,7 +31013,7 @@ void Player::_LoadSkills(PreparedQueryResult result)
                 PreparedStatement* l_Stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHARACTER_SKILL);
                 l_Stmt->setUInt32(0, GetGUIDLow());
                 l_Stmt->setUInt32(1, skill);
-                CharacterDatabase.Execute(l_Stmt);
+                CharacterDatabase.Execute(l_Stmt, GetRealGUIDLow());
 
                 sLog->outError(LOG_FILTER_PLAYER, "Character %u has skill %u that does not exist, delete it.", GetGUIDLow(), skill);
                 continue;
@@ -30799,7 +31038,7 @@ void Player::_LoadSkills(PreparedQueryResult result)
                 PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_CHARACTER_SKILL);
                 stmt->setUInt32(0, GetRealGUIDLow());
                 stmt->setUInt16(1, skill);
-                RealmDatabase.Execute(stmt);
+                RealmDatabase.Execute(stmt, GetRealGUIDLow());
                 continue;
             }
 
@@ -31050,6 +31289,15 @@ void Player::UpdateAchievementCriteria(AchievementCriteriaTypes p_Type, uint64 p
     AchievementCriteriaUpdateTask l_Task;
     l_Task.PlayerGUID = GetGUID();
     l_Task.UnitGUID   = p_Unit ? p_Unit->GetGUID() : 0;
+    l_Task.Type       = p_Type;
+    l_Task.LoginCheck = p_LoginCheck;
+    l_Task.MiscValues[0] = p_MiscValue1;
+    l_Task.MiscValues[1] = p_MiscValue2;
+    l_Task.MiscValues[2] = p_MiscValue3;
+
+    /// The task runs on a map updater thread and reads spells and currencies from the snapshot, publish the current state first
+    RefreshKnowledgeSnapshot();
+
     l_Task.Task = [p_Type, p_MiscValue1, p_MiscValue2, p_MiscValue3, p_LoginCheck](uint64 const& p_PlayerGuid, uint64 const& p_UnitGUID) -> void
     {
         /// Task will be executed async
@@ -31190,6 +31438,7 @@ void Player::ResummonPetTemporaryUnSummonedIfAny()
     Pet*   l_NewPet     = new Pet(this);
     uint64 l_PlayerGUID = GetGUID();
     uint32 l_PetNumber  = m_temporaryUnsummonedPetNumber;
+    uint32 l_PlayerKey  = GetRealGUIDLow();
 
 #ifdef CROSS
     uint32 l_RealmID    = GetSession()->GetInterRealmNumber();
@@ -31198,7 +31447,7 @@ void Player::ResummonPetTemporaryUnSummonedIfAny()
 #endif
 
     PreparedStatement* l_PetStatement = PetQueryHolder::GenerateFirstLoadStatement(0, m_temporaryUnsummonedPetNumber, GetRealGUIDLow(), true, PET_SLOT_UNK_SLOT, l_RealmID);
-    RealmDatabase.AsyncQuery(l_PetStatement, [l_NewPet, l_PlayerGUID, l_PetNumber, l_RealmID](PreparedQueryResult p_Result) -> void
+    RealmDatabase.AsyncQuery(l_PetStatement, [l_NewPet, l_PlayerGUID, l_PetNumber, l_RealmID, l_PlayerKey](PreparedQueryResult p_Result) -> void
     {
         if (!p_Result)
         {
@@ -31222,7 +31471,7 @@ void Player::ResummonPetTemporaryUnSummonedIfAny()
         PetQueryHolder* l_PetHolder = new PetQueryHolder(p_Result->Fetch()[0].GetUInt32(), l_RealmID, p_Result);
         l_PetHolder->Initialize();
 
-        auto l_QueryHolderResultFuture = l_Database->DelayQueryHolder(l_PetHolder);
+        auto l_QueryHolderResultFuture = l_Database->DelayQueryHolder(l_PetHolder, l_PlayerKey);
 
         sWorld->AddQueryHolderCallback(QueryHolderCallback(l_QueryHolderResultFuture, [l_NewPet, l_PlayerGUID, l_PetNumber](SQLQueryHolder* p_QueryHolder) -> void
         {
@@ -31249,7 +31498,7 @@ void Player::ResummonPetTemporaryUnSummonedIfAny()
                     l_Player->CastSpell(l_Player, 118694, true);
             });
         }));
-    });
+    }, l_PlayerKey);
 
     m_temporaryUnsummonedPetNumber = 0;
 }
@@ -31545,7 +31794,7 @@ void Player::SaveArenaData()
     if (!conn)
         return;
 
-    SQLTransaction trans = conn->BeginTransaction();
+    SQLTransaction trans = conn->BeginTransaction(GetRealGUIDLow());
 
     _SaveArenaData(trans);
 
@@ -31608,7 +31857,7 @@ void Player::SaveCrossServerArenaData()
     if (!GetSession() || !GetSession()->GetInterRealmClient())
         return;
 
-    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+    SQLTransaction trans = CharacterDatabase.BeginTransaction(GetRealGUIDLow());
 
     trans->PAppend("REPLACE INTO character_arena_data (guid, realmId, name, class, rating0, bestRatingOfWeek0, bestRatingOfSeason0, matchMakerRating0, weekGames0, weekWins0, prevWeekWins0, seasonGames0, seasonWins0, rating1, bestRatingOfWeek1, bestRatingOfSeason1, matchMakerRating1, weekGames1, weekWins1, prevWeekWins1, seasonGames1, seasonWins1, rating2, bestRatingOfWeek2, bestRatingOfSeason2, matchMakerRating2, weekGames2, weekWins2, prevWeekWins2, seasonGames2, seasonWins2, rating3, bestRatingOfWeek3, bestRatingOfSeason3, matchMakerRating3, weekGames3, weekWins3, prevWeekWins3, seasonGames3, seasonWins3) VALUES "
         "(%u, %u, '%s', %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u, %u)",
@@ -31656,7 +31905,7 @@ void Player::RemoveAtLoginFlagFromDB(uint32 p_Guid, AtLoginFlags p_Flags)
     l_Stmt->setUInt16(0, uint16(p_Flags));
     l_Stmt->setUInt32(1, p_Guid);
 
-    CharacterDatabase.Execute(l_Stmt);
+    CharacterDatabase.Execute(l_Stmt, p_Guid);
 }
 
 void Player::SendClearCooldown(uint32 p_SpellID, Unit* p_Target, bool p_ClearOnHold)
@@ -31803,7 +32052,7 @@ void Player::UpdateSpecCount(uint8 count)
     if (GetActiveSpec() >= count)
         ActivateSpec(0);
 
-    SQLTransaction trans = RealmDatabase.BeginTransaction();
+    SQLTransaction trans = RealmDatabase.BeginTransaction(GetRealGUIDLow());
     PreparedStatement* stmt = NULL;
 
     // Copy spec data
@@ -31851,7 +32100,7 @@ void Player::ActivateSpec(uint8 spec)
     if (IsNonMeleeSpellCasted(false))
         InterruptNonMeleeSpells(false);
 
-    SQLTransaction trans = RealmDatabase.BeginTransaction();
+    SQLTransaction trans = RealmDatabase.BeginTransaction(GetRealGUIDLow());
     _SaveActions(trans);
     RealmDatabase.CommitTransaction(trans);
 
@@ -32278,7 +32527,7 @@ void Player::RefundItem(Item* p_Item)
     uint32 l_MoneyRefund = p_Item->GetPaidMoney();  ///< Item-> will be invalidated in DestroyItem
 
     /// Save all relevant data to DB to prevent desynchronizing exploits
-    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction(GetRealGUIDLow());
 
     /// Delete any references to the refund data
     p_Item->SetNotRefundable(this, true, &l_Transaction);
@@ -32334,7 +32583,7 @@ void Player::SetRandomWinner(bool p_IsWinner, bool p_DatabaseUpdate)
     {
         PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_BATTLEGROUND_RANDOM);
         stmt->setUInt32(0, GetRealGUIDLow());
-        RealmDatabase.Execute(stmt);
+        RealmDatabase.Execute(stmt, GetRealGUIDLow());
     }
 }
 
@@ -32995,7 +33244,7 @@ void Player::SetPersonnalXpRate(float p_PersonnalXPRate)
     PreparedStatement* l_Statement = RealmDatabase.GetPreparedStatement(CHAR_UPD_XP_RATE);
     l_Statement->setFloat(0, p_PersonnalXPRate);
     l_Statement->setUInt32(1, GetRealGUIDLow());
-    RealmDatabase.Execute(l_Statement);
+    RealmDatabase.Execute(l_Statement, GetRealGUIDLow());
 }
 
 void Player::HandleStoreGoldCallback(PreparedQueryResult result)
@@ -33022,13 +33271,13 @@ void Player::HandleStoreGoldCallback(PreparedQueryResult result)
 
             PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_BOUTIQUE_GOLD);
             stmt->setInt32(0, transaction);
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
 
             stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_BOUTIQUE_GOLD_LOG);
             stmt->setInt32(0, transaction);
             stmt->setInt32(1, GetRealGUIDLow());
             stmt->setInt64(2, gold);
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
         }
         while(result->NextRow());
 
@@ -33050,13 +33299,13 @@ void Player::HandleStoreTitleCallback(PreparedQueryResult p_Result)
 
             PreparedStatement* stmt = RealmDatabase.GetPreparedStatement(CHAR_DEL_BOUTIQUE_TITLE);
             stmt->setInt32(0, l_Transaction);
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
 
             stmt = RealmDatabase.GetPreparedStatement(CHAR_INS_BOUTIQUE_TITLE_LOG);
             stmt->setInt32(0, l_Transaction);
             stmt->setInt32(1, GetRealGUIDLow());
             stmt->setInt32(2, l_Title);
-            RealmDatabase.Execute(stmt);
+            RealmDatabase.Execute(stmt, GetRealGUIDLow());
 
             CharTitlesEntry const* l_TitleInfo = sCharTitlesStore.LookupEntry(l_Title);
             if (!l_TitleInfo)
@@ -33093,7 +33342,7 @@ void Player::HandleStoreLevelCallback(PreparedQueryResult result)
 
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_BOUTIQUE_LEVEL);
             stmt->setInt32(0, GetGUIDLow());
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetRealGUIDLow());
         }
     }
 }
@@ -33199,7 +33448,7 @@ void Player::HandleStoreProfessionCallback(PreparedQueryResult p_Result)
         PreparedStatement* l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_DEL_STORE_PROFESSION);
         l_Statement->setUInt32(0, GetGUIDLow());
         l_Statement->setUInt32(1, l_SkillID);
-        CharacterDatabase.Execute(l_Statement);
+        CharacterDatabase.Execute(l_Statement, GetRealGUIDLow());
     }
     while (p_Result->NextRow());
 }
@@ -34096,7 +34345,7 @@ void Player::AddBossLooted(Creature* p_Creature)
     l_Statement->setUInt32(0, GetRealGUIDLow());
     l_Statement->setUInt32(1, p_Creature->GetEntry());
     l_Statement->setUInt32(2, p_Creature->GetNativeDisplayId());
-    RealmDatabase.Execute(l_Statement);
+    RealmDatabase.Execute(l_Statement, GetRealGUIDLow());
 }
 
 bool Player::HasUnlockedReagentBank()
@@ -34172,7 +34421,7 @@ void Player::DeleteGarrison()
     if (!m_Garrison)
         return;
 
-    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction(GetRealGUIDLow());
     m_Garrison->DeleteFromDB(GetGUID(), l_Transaction);
     CharacterDatabase.CommitTransaction(l_Transaction);
 
@@ -35076,7 +35325,7 @@ void Player::AddDailyLootCooldown(uint32 p_Entry)
         PreparedStatement* l_Statement = RealmDatabase.GetPreparedStatement(CHAR_INS_DAILY_LOOT_COOLDOWNS);
         l_Statement->setUInt32(0, GetRealGUIDLow());
         l_Statement->setUInt32(1, p_Entry);
-        RealmDatabase.Execute(l_Statement);
+        RealmDatabase.Execute(l_Statement, GetRealGUIDLow());
     }
 }
 
@@ -35477,7 +35726,7 @@ void Player::RewardCompletedAchievementsIfNeeded()
 
             MailDraft l_Draft(l_Subject, l_Text);
 
-            SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+            SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction(GetRealGUIDLow());
             if (l_Item)
             {
                 // Save new item before send
@@ -35533,12 +35782,14 @@ void Player::_LoadWorldStates(PreparedQueryResult p_Result)
 
 void Player::_SaveCharacterWorldStates(SQLTransaction& p_Transaction)
 {
-    for (auto l_Iterator : m_CharacterWorldStates)
+    for (auto& l_Iterator : m_CharacterWorldStates)
     {
         CharacterWorldState& l_WorldState = l_Iterator.second;
         if (!l_WorldState.Changed)
             continue;
 
+        l_WorldState.Changed = false;
+
         PreparedStatement* l_Statement = RealmDatabase.GetPreparedStatement(CHAR_REP_WORLD_STATES);
         l_Statement->setUInt32(0, GetRealGUIDLow());
         l_Statement->setUInt32(1, l_Iterator.first);
@@ -35813,7 +36064,7 @@ void Player::GetZoneAndAreaId(uint32& p_ZoneId, uint32& p_AreaId, bool p_ForceRe
 
 void Player::HandleFactionChangeActions(char const* p_KnownTitle, uint64 p_GUID, uint8 p_Race, bool p_AtFactionChange)
 {
-    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction(GUID_LOPART(p_GUID));
 
     uint32 l_GUIDLow = GUID_LOPART(p_GUID);
     uint32 l_Team = TeamForRace(p_Race);
@@ -232,9 +232,11 @@ struct PlayerCurrency
 };
 
 typedef std::map<uint32, PlayerTalent*> PlayerTalentMap;
-typedef ACE_Based::LockedMap<uint32, PlayerSpell*> PlayerSpellMap;
+/// Spells, currencies and skills are only touched by the thread updating the player, other threads read PlayerKnowledgeSnapshot
+/// Learning a spell while iterating the spell map may rehash it, collect the ids first
+typedef std::unordered_map<uint32, PlayerSpell*> PlayerSpellMap;
 typedef std::list<SpellModifier*> SpellModList;
-typedef ACE_Based::LockedMap<uint32, PlayerCurrency> PlayerCurrenciesMap;
+typedef std::unordered_map<uint32, PlayerCurrency> PlayerCurrenciesMap;
 
 typedef std::list<uint64> WhisperListContainer;
 
@@ -747,7 +749,61 @@ struct SkillStatusData
     SkillUpdateState uState;
 };
 
-typedef ACE_Based::LockedMap<uint32, SkillStatusData> SkillStatusMap;
+typedef std::unordered_map<uint32, SkillStatusData> SkillStatusMap;
+
+/// Immutable copy of the known spells, skills and currencies, rebuilt by the owner thread once they changed
+/// Code running on another thread (e.g. a guild roster request, achievement criteria tasks) must use it instead of the player containers
+struct PlayerKnowledgeSnapshot
+{
+    struct Skill
+    {
+        uint32 Id;
+        uint16 Value;
+        uint16 Step;
+        uint16 BaseValue;                   ///< As Player::GetBaseSkillValue
+        uint16 PureMaxValue;                ///< As Player::GetPureMaxSkillValue
+
+        bool operator<(Skill const& p_Other) const { return Id < p_Other.Id; }
+    };
+
+    struct Currency
+    {
+        uint32 Id;
+        uint32 Count;
+        uint32 Precision;                   ///< Divisor applied by GetCurrency when asked for precision
+
+        bool operator<(Currency const& p_Other) const { return Id < p_Other.Id; }
+    };
+
+    std::vector<uint32> Spells;             ///< Sorted ids of the known spells, as Player::HasSpell
+    std::vector<Skill> Skills;              ///< Sorted by id
+    std::vector<Currency> Currencies;       ///< Sorted by id
+
+    bool HasSpell(uint32 p_SpellId) const
+    {
+        return std::binary_search(Spells.begin(), Spells.end(), p_SpellId);
+    }
+
+    Skill const* GetSkill(uint32 p_SkillId) const
+    {
+        Skill l_Key = { p_SkillId, 0, 0, 0, 0 };
+        std::vector<Skill>::const_iterator l_Itr = std::lower_bound(Skills.begin(), Skills.end(), l_Key);
+        return (l_Itr != Skills.end() && l_Itr->Id == p_SkillId) ? &(*l_Itr) : nullptr;
+    }
+
+    /// Same as Player::GetCurrency
+    uint32 GetCurrency(uint32 p_CurrencyId, bool p_UsePrecision) const
+    {
+        Currency l_Key = { p_CurrencyId, 0, 1 };
+        std::vector<Currency>::const_iterator l_Itr = std::lower_bound(Currencies.begin(), Currencies.end(), l_Key);
+        if (l_Itr == Currencies.end() || l_Itr->Id != p_CurrencyId)
+            return 0;
+
+        return p_UsePrecision ? l_Itr->Count / l_Itr->Precision : l_Itr->Count;
+    }
+};
+
+typedef std::shared_ptr<PlayerKnowledgeSnapshot const> PlayerKnowledgeSnapshotPtr;
 
 class Quest;
 class Spell;
@@ -1482,6 +1538,29 @@ struct CharacterWorldState
     bool   Changed;
 };
 
+/// Collections rewritten as a whole by Player::SaveToDB, skipped when their content didn't change since the last save
+enum PlayerSaveSnapshot
+{
+    PLAYER_SAVE_SNAPSHOT_AURAS,
+    PLAYER_SAVE_SNAPSHOT_STATS,
+    PLAYER_SAVE_SNAPSHOT_DAILY_TAVERN,
+    PLAYER_SAVE_SNAPSHOT_WEEKLY_TAVERN,
+    PLAYER_SAVE_SNAPSHOT_MAX
+};
+
+/// Content of the snapshot collections known to be in the database, updated by the commit callback of the saves
+struct PlayerSaveSnapshots
+{
+    PlayerSaveSnapshots()
+    {
+        memset(CommittedSave, 0, sizeof(CommittedSave));
+    }
+
+    std::mutex  Lock;
+    uint32      CommittedSave[PLAYER_SAVE_SNAPSHOT_MAX];    ///< Save which committed the content
+    std::string Committed[PLAYER_SAVE_SNAPSHOT_MAX];
+};
+
 namespace MS { namespace Garrison
 {
     class Manager;
@@ -2335,6 +2414,16 @@ class Player : public Unit, public GridObject<Player>
         PlayerSpellMap const& GetSpellMap() const { return m_spells; }
         PlayerSpellMap      & GetSpellMap()       { return m_spells; }
 
+        /// Can be called from any thread, null until the player has been updated once in world
+        PlayerKnowledgeSnapshotPtr GetKnowledgeSnapshot() const { return std::atomic_load(&m_KnowledgeSnapshot); }
+
+        /// Publishes a new snapshot if spells, skills or currencies changed since the last one, only from the thread updating the player
+        void RefreshKnowledgeSnapshot()
+        {
+            if (m_KnowledgeSnapshotDirty || m_CurrencySnapshotDirty)
+                UpdateKnowledgeSnapshot();
+        }
+
         SpellCooldowns const& GetSpellCooldownMap() const { return m_spellCooldowns; }
 
         void AddSpellMod(SpellModifier* mod, bool apply);
@@ -3921,6 +4010,8 @@ class Player : public Unit, public GridObject<Player>
 
         void _SaveActions(SQLTransaction& trans);
         void _SaveAuras(SQLTransaction& trans);
+        /// Returns false if p_Content is the committed content of p_Collection, otherwise queue it to be committed with the current save
+        bool UpdateSaveSnapshot(PlayerSaveSnapshot p_Collection, ByteBuffer const& p_Content, bool p_Force = false);
         void _SaveInventory(SQLTransaction& trans);
         void _SaveVoidStorage(SQLTransaction& trans);
         void _SaveMail(SQLTransaction& trans);
@@ -3968,6 +4059,7 @@ class Player : public Unit, public GridObject<Player>
 
         uint32 m_team;
         uint32 m_nextSave;
+        uint32 m_SaveDeferredTime;                  ///< Time the autosave was delayed by database back-pressure
         time_t m_speakTime;
         uint32 m_speakCount;
         time_t m_pmChatTime;
@@ -4007,6 +4099,12 @@ class Player : public Unit, public GridObject<Player>
 
         PlayerMails m_mail;
         PlayerSpellMap m_spells;
+
+        void UpdateKnowledgeSnapshot();
+
+        PlayerKnowledgeSnapshotPtr m_KnowledgeSnapshot;         ///< Only accessed through std::atomic_load / std::atomic_store
+        bool m_KnowledgeSnapshotDirty;                          ///< Spells or skills changed since the last snapshot
+        bool m_CurrencySnapshotDirty;                           ///< Currency counts changed since the last snapshot
         struct lastPotion_struct
         {
             uint32 m_LastPotionItemID;
@@ -4305,6 +4403,12 @@ class Player : public Unit, public GridObject<Player>
         /// Character WorldState
         std::map<uint32/*WorldState*/, CharacterWorldState> m_CharacterWorldStates;
 
+        /// Content of the collections as committed by the last successful save, see UpdateSaveSnapshot
+        std::shared_ptr<PlayerSaveSnapshots> m_SaveSnapshots;
+        std::vector<std::pair<PlayerSaveSnapshot, std::string>> m_PendingSaveSnapshots;
+        uint32 m_QueuedSaveSnapshots[PLAYER_SAVE_SNAPSHOT_MAX];     ///< Last save which wrote the collection
+        uint32 m_SaveCounter;
+
         /// Armory caches
         float m_MasteryCache;
         uint32 m_EndSalesTimestamp;
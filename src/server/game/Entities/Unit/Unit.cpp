@@ -226,6 +226,7 @@ Unit::Unit(bool isWorldObject): WorldObject(isWorldObject)
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_interruptMask = 0;
+    m_ProcAuraFlagMask = 0;
     m_transform = 0;
     m_canModifyStats = false;
 
@@ -299,7 +300,10 @@ Unit::Unit(bool isWorldObject): WorldObject(isWorldObject)
     _petBattleId = 0;
 
     m_IsInKillingProcess = false;
-    m_VisibilityUpdScheduled = false;
+    m_VisibilityUpdateScheduled = false;
+    m_AINotifyScheduled = false;
+    m_VisibilityUpdateSlot = 0;
+    m_AINotifySlot = 0;
 
     for (int i = 0; i < MAX_POWERS; ++i) ///< Comparison of integers of different signs: 'int' and 'Powers'
         m_lastRegenTime[i] = getMSTime();
@@ -3940,6 +3944,7 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _AddToProcAuraIndex(aurApp);
 
     if (aurSpellInfo->AuraInterruptFlags)
     {
@@ -4040,6 +4045,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveFromProcAuraIndex(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -4179,6 +4185,48 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType p_AuraType)
+{
+    m_AuraModifierCache.erase(p_AuraType);
+}
+
+Unit::AuraModifierCacheEntry const* Unit::FindAuraModifierCache(AuraType p_AuraType, uint64 p_Key) const
+{
+    auto l_Itr = m_AuraModifierCache.find(p_AuraType);
+    if (l_Itr == m_AuraModifierCache.end())
+        return nullptr;
+
+    for (AuraModifierCacheEntry const& l_Entry : l_Itr->second)
+    {
+        if (l_Entry.Key == p_Key)
+            return &l_Entry;
+    }
+
+    return nullptr;
+}
+
+int32 Unit::StoreAuraModifierCache(AuraType p_AuraType, uint64 p_Key, int32 p_Modifier) const
+{
+    AuraModifierCacheEntry l_Entry;
+    l_Entry.Key      = p_Key;
+    l_Entry.Modifier = p_Modifier;
+
+    m_AuraModifierCache[p_AuraType].push_back(l_Entry);
+    return p_Modifier;
+}
+
+float Unit::StoreAuraModifierCache(AuraType p_AuraType, uint64 p_Key, float p_Multiplier) const
+{
+    AuraModifierCacheEntry l_Entry;
+    l_Entry.Key        = p_Key;
+    l_Entry.Multiplier = p_Multiplier;
+
+    m_AuraModifierCache[p_AuraType].push_back(l_Entry);
+    return p_Multiplier;
 }
 
 // All aura base removes should go threw this function!
@@ -5407,6 +5455,17 @@ uint32 Unit::GetDoTsByCaster(uint64 casterGUID) const
 
 int32 Unit::GetTotalAuraModifier(AuraType auratype, AuraEffect const* excludeAura /* nullptr*/, AuraEffect* includeAura /* nullptr*/) const
 {
+    if (!includeAura && m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_TOTAL, 0);
+    bool l_Cacheable = !excludeAura && !includeAura;
+    if (l_Cacheable)
+    {
+        if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+            return l_Cached->Modifier;
+    }
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -5426,11 +5485,18 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype, AuraEffect const* excludeAur
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
-    return modifier;
+    return l_Cacheable ? StoreAuraModifierCache(auratype, l_CacheKey, modifier) : modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MULTIPLIER, 0);
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Multiplier;
+
     float multiplier = 1.0f;
 
     std::map<SpellGroup, int32> SameEffectSpellGroup;
@@ -5446,11 +5512,18 @@ float Unit::GetTotalAuraMultiplier(AuraType auratype) const
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
-    return multiplier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, multiplier);
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MAX_POSITIVE, 0);
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Modifier;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5460,11 +5533,18 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
             modifier = (*i)->GetAmount();
     }
 
-    return modifier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, modifier);
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MAX_NEGATIVE, 0);
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Modifier;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5479,11 +5559,22 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
         }
     }
 
-    return modifier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, modifier);
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, AuraEffect const* excludeAura /* nullptr*/, AuraEffect* includeAura /* nullptr*/) const
 {
+    if (!includeAura && m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_TOTAL_MISC_MASK, misc_mask);
+    bool l_Cacheable = !excludeAura && !includeAura;
+    if (l_Cacheable)
+    {
+        if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+            return l_Cached->Modifier;
+    }
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -5503,11 +5594,22 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask,
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
-    return modifier;
+    return l_Cacheable ? StoreAuraModifierCache(auratype, l_CacheKey, modifier) : modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscBMask(AuraType auratype, uint32 misc_mask, AuraEffect const* excludeAura /* nullptr*/, AuraEffect* includeAura /* nullptr*/) const
 {
+    if (!includeAura && m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_TOTAL_MISC_B_MASK, misc_mask);
+    bool l_Cacheable = !excludeAura && !includeAura;
+    if (l_Cacheable)
+    {
+        if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+            return l_Cached->Modifier;
+    }
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -5528,11 +5630,18 @@ int32 Unit::GetTotalAuraModifierByMiscBMask(AuraType auratype, uint32 misc_mask,
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
-    return modifier;
+    return l_Cacheable ? StoreAuraModifierCache(auratype, l_CacheKey, modifier) : modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MULTIPLIER_MISC_MASK, misc_mask);
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Multiplier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     float multiplier = 1.0f;
 
@@ -5551,11 +5660,22 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
-    return multiplier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, multiplier);
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, AuraEffect const* except) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MAX_POSITIVE_MISC_MASK, misc_mask);
+    bool l_Cacheable = !except;
+    if (l_Cacheable)
+    {
+        if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+            return l_Cached->Modifier;
+    }
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5565,11 +5685,18 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
             modifier = (*i)->GetAmount();
     }
 
-    return modifier;
+    return l_Cacheable ? StoreAuraModifierCache(auratype, l_CacheKey, modifier) : modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MAX_NEGATIVE_MISC_MASK, misc_mask);
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Modifier;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5579,11 +5706,18 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
             modifier = (*i)->GetAmount();
     }
 
-    return modifier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, modifier);
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_TOTAL_MISC_VALUE, uint32(misc_value));
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Modifier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -5598,11 +5732,18 @@ int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value)
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
-    return modifier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, modifier);
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MULTIPLIER_MISC_VALUE, uint32(misc_value));
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Multiplier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     float multiplier = 1.0f;
 
@@ -5617,11 +5758,18 @@ float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_valu
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         AddPct(multiplier, itr->second);
 
-    return multiplier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, multiplier);
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MAX_POSITIVE_MISC_VALUE, uint32(misc_value));
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Modifier;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5631,11 +5779,18 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_
             modifier = (*i)->GetAmount();
     }
 
-    return modifier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, modifier);
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    uint64 l_CacheKey = MakeAuraModifierCacheKey(AURA_MODIFIER_CACHE_MAX_NEGATIVE_MISC_VALUE, uint32(misc_value));
+    if (AuraModifierCacheEntry const* l_Cached = FindAuraModifierCache(auratype, l_CacheKey))
+        return l_Cached->Modifier;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5645,7 +5800,7 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_
             modifier = (*i)->GetAmount();
     }
 
-    return modifier;
+    return StoreAuraModifierCache(auratype, l_CacheKey, modifier);
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
@@ -10824,6 +10979,9 @@ void Unit::ModifyAuraState(AuraStateType flag, bool apply)
             SetFlag(UNIT_FIELD_AURA_STATE, 1<<(flag-1));
             if (IsPlayer())
             {
+                /// Casting may learn spells and rehash the spell map, cast once the iteration is over
+                std::vector<uint32> l_SpellsToCast;
+
                 PlayerSpellMap const& sp_list = ToPlayer()->GetSpellMap();
                 for (PlayerSpellMap::const_iterator itr = sp_list.begin(); itr != sp_list.end(); ++itr)
                 {
@@ -10839,8 +10997,11 @@ void Unit::ModifyAuraState(AuraStateType flag, bool apply)
                         continue;
 
                     if (spellInfo->CasterAuraState == uint32(flag))
-                        CastSpell(this, itr->first, true, NULL);
+                        l_SpellsToCast.push_back(itr->first);
                 }
+
+                for (uint32 l_SpellId : l_SpellsToCast)
+                    CastSpell(this, l_SpellId, true, NULL);
             }
             else if (Pet* pet = ToCreature()->ToPet())
             {
@@ -16360,6 +16521,9 @@ void Unit::RemoveFromWorld()
             }
         }
 
+        if (m_VisibilityUpdateScheduled || m_AINotifyScheduled)
+            GetMap()->CancelVisibilityUpdates(this);
+
         WorldObject::RemoveFromWorld();
         m_duringRemoveFromWorld = false;
     }
@@ -16744,7 +16908,72 @@ struct ProcTriggeredData
     uint32 effMask;
 };
 
-typedef std::list< ProcTriggeredData > ProcTriggeredList;
+typedef std::vector< ProcTriggeredData > ProcTriggeredList;
+
+/// Proc flags IsTriggeredAtSpellProcEvent may accept for this spell, 0 if it never does
+static uint32 GetProcAuraIndexFlags(SpellInfo const* p_SpellInfo)
+{
+    /// Handled by the new proc system
+    if (sSpellMgr->GetSpellProcEntry(p_SpellInfo->Id))
+        return 0;
+
+    SpellProcEventEntry const* l_SpellProcEvent = sSpellMgr->GetSpellProcEvent(p_SpellInfo->Id);
+    uint32 l_ProcFlags = l_SpellProcEvent && l_SpellProcEvent->procFlags ? l_SpellProcEvent->procFlags : p_SpellInfo->ProcFlags;
+    if (!l_ProcFlags)
+        return 0;
+
+    /// Hacks of IsTriggeredAtSpellProcEvent letting these auras proc outside of their proc flags
+    switch (p_SpellInfo->Id)
+    {
+        case 44448:
+        case 76669:
+        case 108446:
+        case 121152:
+        case 165459:
+        case 165476:
+            return 0xFFFFFFFF;
+        default:
+            break;
+    }
+
+    return l_ProcFlags;
+}
+
+void Unit::_AddToProcAuraIndex(AuraApplication* p_AurApp)
+{
+    SpellInfo const* l_SpellInfo = p_AurApp->GetBase()->GetSpellInfo();
+
+    ProcAuraIndexEntry l_Entry;
+    l_Entry.Application = p_AurApp;
+    l_Entry.SpellId     = l_SpellInfo->Id;
+    l_Entry.ProcFlags   = GetProcAuraIndexFlags(l_SpellInfo);
+
+    if (!l_Entry.ProcFlags)
+        return;
+
+    /// Same position as in m_appliedAuras: after every application of a lower or equal spell id
+    std::vector<ProcAuraIndexEntry>::iterator l_Itr = std::upper_bound(m_ProcAuraIndex.begin(), m_ProcAuraIndex.end(), l_Entry.SpellId,
+        [](uint32 p_SpellId, ProcAuraIndexEntry const& p_Other) { return p_SpellId < p_Other.SpellId; });
+
+    m_ProcAuraIndex.insert(l_Itr, l_Entry);
+    m_ProcAuraFlagMask |= l_Entry.ProcFlags;
+}
+
+void Unit::_RemoveFromProcAuraIndex(AuraApplication* p_AurApp)
+{
+    for (std::vector<ProcAuraIndexEntry>::iterator l_Itr = m_ProcAuraIndex.begin(); l_Itr != m_ProcAuraIndex.end(); ++l_Itr)
+    {
+        if (l_Itr->Application != p_AurApp)
+            continue;
+
+        m_ProcAuraIndex.erase(l_Itr);
+
+        m_ProcAuraFlagMask = 0;
+        for (ProcAuraIndexEntry const& l_Entry : m_ProcAuraIndex)
+            m_ProcAuraFlagMask |= l_Entry.ProcFlags;
+        return;
+    }
+}
 
 // List of auras that CAN be trigger but may not exist in spell_proc_event
 // in most case need for drop charges
@@ -17055,13 +17284,31 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     uint32 now = getMSTime();
 
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    // Fill procTriggered list, only auras listening to one of the event proc flags can trigger
+    // The proc checks can apply or remove auras, so the candidates are copied before any of them runs
+    std::vector<ProcAuraIndexEntry> l_Candidates;
+    if (m_ProcAuraFlagMask & procFlag)
     {
+        l_Candidates.reserve(m_ProcAuraIndex.size());
+        for (ProcAuraIndexEntry const& l_Entry : m_ProcAuraIndex)
+        {
+            if (l_Entry.ProcFlags & procFlag)
+                l_Candidates.push_back(l_Entry);
+        }
+    }
+
+    for (ProcAuraIndexEntry const& l_Entry : l_Candidates)
+    {
+        AuraApplication* l_AurApp = l_Entry.Application;
+
+        // Removed by the check of a previous candidate, the application is only deleted at the next aura update
+        if (l_AurApp->GetRemoveMode() || l_AurApp->GetBase()->IsRemoved())
+            continue;
+
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == l_Entry.SpellId)
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(l_AurApp->GetBase());
 
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = (damage + absorb) || (procExtra & PROC_EX_BLOCK && isVictim);
@@ -17069,7 +17316,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
         // only auras that has triggered spell should proc from fully absorbed damage
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = l_AurApp->GetBase()->GetSpellInfo();
         if ((procExtra & PROC_EX_ABSORB && isVictim) || (procFlag & PROC_FLAG_DONE_SPELL_MAGIC_DMG_CLASS_NEG))
         {
             bool triggerSpell = false;
@@ -17086,12 +17333,12 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
         // Custom MoP Script
         // Breath of Fire DoT shoudn't remove Breath of Fire disorientation - Hack Fix
-        if (procSpell && procSpell->Id == 123725 && itr->first == 123393)
+        if (procSpell && procSpell->Id == 123725 && l_Entry.SpellId == 123393)
             continue;
 
         /// Custom WoD Script
         /// Ruthlessness can proc just from finishing spells
-        if (itr->first == 14161 && (!procSpell || (procSpell && procSpell->Id != 2098 && procSpell->Id != 408 && procSpell->Id != 26679 && procSpell->Id != 1943 && procSpell->Id != 121411)))
+        if (l_Entry.SpellId == 14161 && (!procSpell || (procSpell && procSpell->Id != 2098 && procSpell->Id != 408 && procSpell->Id != 26679 && procSpell->Id != 1943 && procSpell->Id != 121411)))
             continue;
 
         /// Item - Druid T17 Restoration 4P Bonus - 167714
@@ -17106,7 +17353,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             continue;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(l_AurApp, eventInfo))
             continue;
 
         bool procSuccess = RollProcResult(target, triggerData.aura, attType, isVictim, triggerData.spellProcEvent);
@@ -17118,11 +17365,11 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool triggered = !(spellProto->AttributesEx3 & SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED) ?
             (procExtra & PROC_EX_INTERNAL_TRIGGERED && !(procFlag & PROC_FLAG_DONE_TRAP_ACTIVATION)) : false;
 
-        for (uint8 i = 0; i < itr->second->GetEffectCount(); ++i)
+        for (uint8 i = 0; i < l_AurApp->GetEffectCount(); ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (l_AurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = l_AurApp->GetBase()->GetEffect(i);
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
                     continue;
@@ -17135,7 +17382,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             }
         }
         if (triggerData.effMask)
-            procTriggered.push_front(triggerData);
+            procTriggered.push_back(triggerData);
     }
 
     // Nothing found
@@ -17146,8 +17393,8 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     if (procExtra & (PROC_EX_INTERNAL_TRIGGERED | PROC_EX_INTERNAL_CANT_PROC))
         SetCantProc(true);
 
-    // Handle effects proceed this time
-    for (ProcTriggeredList::const_iterator i = procTriggered.begin(); i != procTriggered.end(); ++i)
+    // Handle effects proceed this time, latest spell ids first
+    for (ProcTriggeredList::const_reverse_iterator i = procTriggered.rbegin(); i != procTriggered.rend(); ++i)
     {
         // look for aura in auras list, it may be removed while proc event processing
         if (i->aura->IsRemoved())
@@ -20185,15 +20432,11 @@ void Unit::SetPhaseMask(uint32 newPhaseMask, bool update)
             // modify threat lists for new phasemask
             if (GetTypeId() != TYPEID_PLAYER)
             {
-                std::list<HostileReference*> threatList = getThreatManager().getThreatList();
-                std::list<HostileReference*> offlineThreatList = getThreatManager().getOfflineThreatList();
-
-                // merge expects sorted lists
-                threatList.sort();
-                offlineThreatList.sort();
-                threatList.merge(offlineThreatList);
+                ThreatContainer::StorageType threatList = getThreatManager().getThreatList();
+                ThreatContainer::StorageType const& offlineThreatList = getThreatManager().getOfflineThreatList();
+                threatList.insert(threatList.end(), offlineThreatList.begin(), offlineThreatList.end());
 
-                for (std::list<HostileReference*>::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                     if (Unit* unit = (*itr)->getTarget())
                         unit->getHostileRefManager().setOnlineOfflineState(ToCreature(), unit->InSamePhase(newPhaseMask));
             }
@@ -20215,34 +20458,6 @@ void Unit::SetPhaseMask(uint32 newPhaseMask, bool update)
                 summon->SetPhaseMask(newPhaseMask, true);
 }
 
-class Unit::AINotifyTask : public BasicEvent
-{
-    Unit& m_owner;
-public:
-    explicit AINotifyTask(Unit * me) : BasicEvent(), m_owner(*me)
-    {
-        m_owner.m_VisibilityUpdScheduled = true;
-    }
-
-    ~AINotifyTask()
-    {
-        m_owner.m_VisibilityUpdScheduled = false;
-    }
-
-    virtual bool Execute(uint64 , uint32)
-    {
-        JadeCore::AIRelocationNotifier notifier(m_owner);
-        m_owner.VisitNearbyObject(60.0f, notifier);
-        return true;
-    }
-
-    static void ScheduleAINotify(Unit* me)
-    {
-        if (!me->m_VisibilityUpdScheduled)
-            me->m_Events.AddEvent(new AINotifyTask(me), me->m_Events.CalculateTime(World::Visibility_AINotifyDelay));
-    }
-};
-
 float g_RequiredMoveDistanceSq[6] =
 {
     20.0f,  ///< MAP_COMMON
@@ -20253,51 +20468,38 @@ float g_RequiredMoveDistanceSq[6] =
     25.0f   ///< MAP_SCENARIO
 };
 
-class Unit::VisibilityUpdateTask : public BasicEvent
+bool Unit::UpdateVisibilityIfMoved()
 {
-    Unit& m_owner;
-public:
-    explicit VisibilityUpdateTask(Unit * me) : BasicEvent(), m_owner(*me) {}
-
-    virtual bool Execute(uint64 , uint32)
+    if (!m_sharedVision.empty())
     {
-        UpdateVisibility(&m_owner);
-        return true;
-    }
-
-    static void UpdateVisibility(Unit* me)
-    {
-        if (!me->m_sharedVision.empty())
+        for (SharedVisionList::const_iterator l_Itr = m_sharedVision.begin(); l_Itr != m_sharedVision.end();)
         {
-            for (SharedVisionList::const_iterator it = me->m_sharedVision.begin(); it != me->m_sharedVision.end();)
-            {
-                Player * tmp = *it;
-                ++it;
-                tmp->UpdateVisibilityForPlayer();
-            }
+            Player* l_Player = *l_Itr;
+            ++l_Itr;
+            l_Player->UpdateVisibilityForPlayer();
         }
+    }
 
-        Map* l_Map = me->FindMap();
-        if (!l_Map)
-            return;
+    Map* l_Map = FindMap();
+    if (!l_Map)
+        return false;
 
-        float l_DistanceX = me->m_LastNotifyPosition.GetPositionX() - me->GetPositionX();
-        float l_DistanceY = me->m_LastNotifyPosition.GetPositionY() - me->GetPositionY();
-        float l_DistanceZ = me->m_LastNotifyPosition.GetPositionZ() - me->GetPositionZ();
-        float l_DistanceSQ = l_DistanceX*l_DistanceX + l_DistanceY*l_DistanceY + l_DistanceZ*l_DistanceZ;
+    float l_DistanceX = m_LastNotifyPosition.GetPositionX() - GetPositionX();
+    float l_DistanceY = m_LastNotifyPosition.GetPositionY() - GetPositionY();
+    float l_DistanceZ = m_LastNotifyPosition.GetPositionZ() - GetPositionZ();
+    float l_DistanceSQ = l_DistanceX*l_DistanceX + l_DistanceY*l_DistanceY + l_DistanceZ*l_DistanceZ;
 
-        float l_MinDistanceSQ = g_RequiredMoveDistanceSq[l_Map->GetEntry()->instanceType];
-        if (l_DistanceSQ < l_MinDistanceSQ)
-            return;
+    float l_MinDistanceSQ = g_RequiredMoveDistanceSq[l_Map->GetEntry()->instanceType];
+    if (l_DistanceSQ < l_MinDistanceSQ)
+        return false;
 
-        me->m_LastNotifyPosition.Relocate(me->GetPositionX(), me->GetPositionY(), me->GetPositionZ());
+    m_LastNotifyPosition.Relocate(GetPositionX(), GetPositionY(), GetPositionZ());
 
-        if (me->isType(TYPEMASK_PLAYER))
-            ((Player*)me)->UpdateVisibilityForPlayer();
+    if (isType(TYPEMASK_PLAYER))
+        ((Player*)this)->UpdateVisibilityForPlayer();
 
-        me->WorldObject::UpdateObjectVisibility(true);
-    }
-};
+    return true;
+}
 
 void Unit::UpdateObjectVisibility(bool forced)
 {
@@ -20308,9 +20510,17 @@ void Unit::UpdateObjectVisibility(bool forced)
 
         WorldObject::UpdateObjectVisibility(true);
     }
-    else
-        m_Events.AddEvent(new VisibilityUpdateTask(this), m_Events.CalculateTime(1));
-    AINotifyTask::ScheduleAINotify(this);
+
+    /// Units out of the world have nobody to notify, they are refreshed when added to a map
+    if (!IsInWorld())
+        return;
+
+    /// The next map visibility pass handles the unit along with every other unit that moved
+    if (!forced && !m_VisibilityUpdateScheduled)
+        GetMap()->ScheduleVisibilityUpdate(this);
+
+    if (!m_AINotifyScheduled)
+        GetMap()->ScheduleAINotify(this);
 }
 
 void Unit::SendMoveKnockBack(Player* p_Player, float p_SpeedXY, float p_SpeedZ, float p_Cos, float p_Sin)
@@ -22141,8 +22351,8 @@ void Unit::SendThreatListUpdate()
         l_Data.appendPackGUID(GetGUID());
         l_Data << l_Count;
 
-        std::list<HostileReference*>& l_ThreatList = getThreatManager().getThreatList();
-        for (std::list<HostileReference*>::const_iterator l_Iter = l_ThreatList.begin(); l_Iter != l_ThreatList.end(); ++l_Iter)
+        ThreatContainer::StorageType& l_ThreatList = getThreatManager().getThreatList();
+        for (ThreatContainer::StorageType::const_iterator l_Iter = l_ThreatList.begin(); l_Iter != l_ThreatList.end(); ++l_Iter)
         {
             l_Data.appendPackGUID((*l_Iter)->getUnitGuid());
             l_Data << uint32((*l_Iter)->getThreat());
@@ -22163,8 +22373,8 @@ void Unit::SendChangeCurrentVictimOpcode(HostileReference* p_HostileReference)
         l_Data.appendPackGUID(p_HostileReference->getUnitGuid());
         l_Data << l_Count;
 
-        std::list<HostileReference*>& l_ThreatList = getThreatManager().getThreatList();
-        for (std::list<HostileReference*>::const_iterator l_Iter = l_ThreatList.begin(); l_Iter != l_ThreatList.end(); ++l_Iter)
+        ThreatContainer::StorageType& l_ThreatList = getThreatManager().getThreatList();
+        for (ThreatContainer::StorageType::const_iterator l_Iter = l_ThreatList.begin(); l_Iter != l_ThreatList.end(); ++l_Iter)
         {
             l_Data.appendPackGUID((*l_Iter)->getUnitGuid());
             l_Data << uint32((*l_Iter)->getThreat());
@@ -22614,7 +22824,7 @@ Unit* Unit::GetSimulacrumTarget()
         return NULL;
 }
 
-void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const
+void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target, ViewerFieldList* viewerFields) const
 {
     if (!target)
         return;
@@ -22627,30 +22837,27 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     uint32* flags;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
-    Creature const* creature = ToCreature();
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    /// Offset in data of the first value, the block count and the mask come first
+    uint32 fieldsOffset = data->wpos() + 1 + ((m_valuesCount + UpdateMask::CLIENT_UPDATE_MASK_BITS - 1) / UpdateMask::CLIENT_UPDATE_MASK_BITS) * sizeof(UpdateMask::ClientUpdateMaskType);
+
+    bool perCasterAuraState = HasFlag(UNIT_FIELD_AURA_STATE, PER_CASTER_AURA_STATE_MASK);
+
+    ForEachUpdateFieldCandidate(updateType, flags, _fieldNotifyFlags | (visibleFlag & UF_FLAG_SPECIAL_INFO), perCasterAuraState ? int32(UNIT_FIELD_AURA_STATE) : -1, [&](uint16 index)
     {
         if (_fieldNotifyFlags & flags[index] ||
             ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
             ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == UNIT_FIELD_AURA_STATE && HasFlag(UNIT_FIELD_AURA_STATE, PER_CASTER_AURA_STATE_MASK)))
+            (index == UNIT_FIELD_AURA_STATE && perCasterAuraState))
         {
             updateMask.SetBit(index);
 
-            if (index == UNIT_FIELD_NPC_FLAGS)
+            uint32 viewerValue;
+            if (GetViewerDependentValue(index, target, viewerValue))
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_NPC_FLAGS];
+                if (viewerFields)
+                    viewerFields->emplace_back(fieldsOffset + fieldBuffer.wpos(), index);
 
-                if (creature)
-                    if (!target->canSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURA_STATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
+                fieldBuffer << uint32(viewerValue);
             }
             // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
             else if (index >= UNIT_FIELD_ATTACK_ROUND_BASE_TIME && index <= UNIT_FIELD_RANGED_ATTACK_ROUND_BASE_TIME)
@@ -22666,116 +22873,142 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
             {
                 fieldBuffer << uint32(m_floatValues[index]);
             }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
+            else
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->isGameMaster())
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
-
-                fieldBuffer << uint32(appendValue);
+                // send in current format (float as float, uint32 as uint32)
+                fieldBuffer << m_uint32Values[index];
             }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAY_ID)
+        }
+    });
+
+    *data << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(data);
+    data->append(fieldBuffer);
+}
+
+bool Unit::GetViewerDependentValue(uint16 index, Player* target, uint32& value) const
+{
+    Creature const* creature = ToCreature();
+
+    switch (index)
+    {
+        case UNIT_FIELD_NPC_FLAGS:
+        {
+            value = m_uint32Values[UNIT_FIELD_NPC_FLAGS];
+
+            if (creature)
+                if (!target->canSeeSpellClickOn(creature))
+                    value &= ~UNIT_NPC_FLAG_SPELLCLICK;
+
+            return true;
+        }
+        case UNIT_FIELD_AURA_STATE:
+        {
+            // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+            value = BuildAuraStateUpdateForTarget(target);
+            return true;
+        }
+        // Gamemasters should be always able to select units - remove not selectable flag
+        case UNIT_FIELD_FLAGS:
+        {
+            value = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->isGameMaster())
+                value &= ~UNIT_FLAG_NOT_SELECTABLE;
+
+            return true;
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        case UNIT_FIELD_DISPLAY_ID:
+        {
+            value = m_uint32Values[UNIT_FIELD_DISPLAY_ID];
+            if (creature)
             {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAY_ID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (uint8 i = 0; i < transform->EffectCount; ++i)
-                            if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (uint8 i = 0; i < transform->EffectCount; ++i)
+                        if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
 
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                {
+                    if (target->isGameMaster())
                     {
-                        if (target->isGameMaster())
-                        {
-                            if (cinfo->Modelid1)
-                                displayId = cinfo->Modelid1; // Modelid1 is a visible model for gms
-                            else
-                                displayId = 17519; // world visible trigger's model
-                        }
+                        if (cinfo->Modelid1)
+                            value = cinfo->Modelid1; // Modelid1 is a visible model for gms
                         else
-                        {
-                            if (cinfo->Modelid2)
-                                displayId = cinfo->Modelid2; // Modelid2 is an invisible model for players
-                            else
-                                displayId = 11686; // world invisible trigger's model
-                        }
+                            value = 17519; // world visible trigger's model
+                    }
+                    else
+                    {
+                        if (cinfo->Modelid2)
+                            value = cinfo->Modelid2; // Modelid2 is an invisible model for players
+                        else
+                            value = 11686; // world invisible trigger's model
                     }
                 }
-
-                fieldBuffer << uint32(displayId);
             }
-            // hide lootable animation for unallowed players
-            else if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[OBJECT_FIELD_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
+            return true;
+        }
+        // hide lootable animation for unallowed players
+        case OBJECT_FIELD_DYNAMIC_FLAGS:
+        {
+            value = m_uint32Values[OBJECT_FIELD_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+            if (creature)
+            {
+                if (creature->hasLootRecipient())
+                {
+                    value |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->isTappedBy(target))
+                        value |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-
-                fieldBuffer << dynamicFlags;
+                if (!target->isAllowedToLoot(creature))
+                    value &= ~UNIT_DYNFLAG_LOOTABLE;
             }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_SHAPESHIFT_FORM || index == UNIT_FIELD_FACTION_TEMPLATE)
-            {
-                uint32 l_Value = m_uint32Values[index];
-                if (index == UNIT_FIELD_FACTION_TEMPLATE && creature && creature->IsAIEnabled)
-                    creature->AI()->OnSendFactionTemplate(l_Value, target);
 
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (value & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    value &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+            return true;
+        }
+        // FG: pretend that OTHER players in own group are friendly ("blue")
+        case UNIT_FIELD_SHAPESHIFT_FORM:
+        case UNIT_FIELD_FACTION_TEMPLATE:
+        {
+            value = m_uint32Values[index];
+            if (index == UNIT_FIELD_FACTION_TEMPLATE && creature && creature->IsAIEnabled)
+                creature->AI()->OnSendFactionTemplate(value, target);
+
+            if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+            {
+                FactionTemplateEntry const* ft1 = getFactionTemplateEntry();
+                FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
                 {
-                    FactionTemplateEntry const* ft1 = getFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_SHAPESHIFT_FORM)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_SHAPESHIFT_FORM] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->getFaction());
-                    }
+                    if (index == UNIT_FIELD_SHAPESHIFT_FORM)
+                        // Allow targetting opposite faction in party when enabled in config
+                        value = m_uint32Values[UNIT_FIELD_SHAPESHIFT_FORM] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
                     else
-                        fieldBuffer << l_Value;
+                        // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                        value = target->getFaction();
                 }
-                else
-                    fieldBuffer << l_Value;
-            }
-            else
-            {
-                // send in current format (float as float, uint32 as uint32)
-                fieldBuffer << m_uint32Values[index];
             }
+
+            return true;
         }
+        default:
+            return false;
     }
-
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
 }
 
 float Unit::CalculateDamageDealtFactor(Unit* p_Unit, Creature* p_Creature)
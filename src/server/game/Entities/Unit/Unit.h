@@ -2223,6 +2223,9 @@ class Unit : public WorldObject
         int32 GetMaxPositiveAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const;
         int32 GetMaxNegativeAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const;
 
+        /// Drop the cached aggregates of an aura type, must be called when one of its effects is added, removed or changes amount
+        void InvalidateAuraModifierCache(AuraType p_AuraType);
+
         float GetResistanceBuffMods(SpellSchools school, bool positive) const { return GetFloatValue(positive ? UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE+school : UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE+school); }
         void SetResistanceBuffMods(SpellSchools school, bool positive, float val) { SetFloatValue(positive ? UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE+school : UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE+school, val); }
         void ApplyResistanceBuffModsMod(SpellSchools school, bool positive, float val, bool apply) { ApplyModSignedFloatValue(positive ? UNIT_FIELD_RESISTANCE_BUFF_MODS_POSITIVE+school : UNIT_FIELD_RESISTANCE_BUFF_MODS_NEGATIVE+school, val, apply); }
@@ -2333,6 +2336,22 @@ class Unit : public WorldObject
         void SetPhaseMask(uint32 newPhaseMask, bool update);// overwrite WorldObject::SetPhaseMask
         void UpdateObjectVisibility(bool forced = true);
 
+        /// Pending flags of the map visibility batches (Map::ProcessVisibilityUpdates)
+        bool IsVisibilityUpdateScheduled() const { return m_VisibilityUpdateScheduled; }
+        void SetVisibilityUpdateScheduled(bool p_Scheduled) { m_VisibilityUpdateScheduled = p_Scheduled; }
+        bool IsAINotifyScheduled() const { return m_AINotifyScheduled; }
+        void SetAINotifyScheduled(bool p_Scheduled) { m_AINotifyScheduled = p_Scheduled; }
+
+        /// Position of the unit in the visibility / AI notify queue, so it can be cancelled without a scan
+        uint32 GetVisibilityUpdateSlot() const { return m_VisibilityUpdateSlot; }
+        void SetVisibilityUpdateSlot(uint32 p_Slot) { m_VisibilityUpdateSlot = p_Slot; }
+        uint32 GetAINotifySlot() const { return m_AINotifySlot; }
+        void SetAINotifySlot(uint32 p_Slot) { m_AINotifySlot = p_Slot; }
+
+        /// Refresh the shared visions and, once moved far enough since the last notify, the player own visibility
+        /// Returns true if the nearby players must update their visibility of the unit
+        bool UpdateVisibilityIfMoved();
+
         SpellImmuneList m_spellImmune[MAX_SPELL_IMMUNITY];
         uint32 m_lastSanctuaryTime;
 
@@ -2789,7 +2808,8 @@ class Unit : public WorldObject
     protected:
         explicit Unit (bool isWorldObject);
 
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target, ViewerFieldList* viewerFields = nullptr) const;
+        bool GetViewerDependentValue(uint16 index, Player* target, uint32& value) const;
 
         UnitAI* i_AI, *i_disabledAI;
 
@@ -2831,6 +2851,60 @@ class Unit : public WorldObject
         uint32 m_removedAurasCount;
         AuraStackOnDurationMap m_StackOnDurationMap;
         AuraEffectList m_modAuras[TOTAL_AURAS];
+
+        /// Results of the GetTotalAuraModifier family, keyed by (kind, misc value or mask) inside the bucket of their aura type
+        enum AuraModifierCacheKind
+        {
+            AURA_MODIFIER_CACHE_TOTAL,
+            AURA_MODIFIER_CACHE_MULTIPLIER,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE,
+            AURA_MODIFIER_CACHE_TOTAL_MISC_MASK,
+            AURA_MODIFIER_CACHE_TOTAL_MISC_B_MASK,
+            AURA_MODIFIER_CACHE_MULTIPLIER_MISC_MASK,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE_MISC_MASK,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE_MISC_MASK,
+            AURA_MODIFIER_CACHE_TOTAL_MISC_VALUE,
+            AURA_MODIFIER_CACHE_MULTIPLIER_MISC_VALUE,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE_MISC_VALUE,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE_MISC_VALUE
+        };
+
+        struct AuraModifierCacheEntry
+        {
+            uint64 Key;
+            union
+            {
+                int32 Modifier;
+                float Multiplier;
+            };
+        };
+
+        static uint64 MakeAuraModifierCacheKey(AuraModifierCacheKind p_Kind, uint32 p_Misc)
+        {
+            return (uint64(p_Kind) << 32) | p_Misc;
+        }
+
+        AuraModifierCacheEntry const* FindAuraModifierCache(AuraType p_AuraType, uint64 p_Key) const;
+        int32 StoreAuraModifierCache(AuraType p_AuraType, uint64 p_Key, int32 p_Modifier) const;
+        float StoreAuraModifierCache(AuraType p_AuraType, uint64 p_Key, float p_Multiplier) const;
+
+        /// One bucket per aura type with cached results, dropped as a whole when an effect of that type is registered or removed
+        mutable std::unordered_map<uint32 /*AuraType*/, std::vector<AuraModifierCacheEntry>> m_AuraModifierCache;
+
+        /// Applications ProcDamageAndSpellFor can trigger, in m_appliedAuras order, with the proc flags they listen to
+        struct ProcAuraIndexEntry
+        {
+            AuraApplication* Application;
+            uint32 SpellId;
+            uint32 ProcFlags;
+        };
+
+        void _AddToProcAuraIndex(AuraApplication* p_AurApp);
+        void _RemoveFromProcAuraIndex(AuraApplication* p_AurApp);
+
+        std::vector<ProcAuraIndexEntry> m_ProcAuraIndex;
+        uint32 m_ProcAuraFlagMask;                 ///< Union of the proc flags of m_ProcAuraIndex
         AuraList m_scAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -2925,10 +2999,11 @@ class Unit : public WorldObject
         void SetStunned(bool apply);
 
     private:
-        class AINotifyTask;
-        class VisibilityUpdateTask;
         Position m_lastVisibilityUpdPos;
-        bool m_VisibilityUpdScheduled;
+        bool m_VisibilityUpdateScheduled;
+        bool m_AINotifyScheduled;
+        uint32 m_VisibilityUpdateSlot;
+        uint32 m_AINotifySlot;
         uint32 m_rootTimes;
 
         uint32 m_state;                                     // Even derived shouldn't modify
@@ -473,6 +473,15 @@ void ObjectAccessor::Update(uint32 /*diff*/)
             iter->first->GetSession()->SendPacket(&packet);
         packet.clear();                                     // clean the string
     }
+
+    /// Map threads are idle here, index tables replaced during the previous update can be freed
+    HashMapHolder<Player>::ReclaimRetired();
+    HashMapHolder<Pet>::ReclaimRetired();
+    HashMapHolder<GameObject>::ReclaimRetired();
+    HashMapHolder<DynamicObject>::ReclaimRetired();
+    HashMapHolder<Creature>::ReclaimRetired();
+    HashMapHolder<Corpse>::ReclaimRetired();
+    HashMapHolder<Transport>::ReclaimRetired();
 }
 
 void ObjectAccessor::UnloadAll()
@@ -488,6 +497,10 @@ void ObjectAccessor::UnloadAll()
 
 template <class T> std::unordered_map< uint64, T* > HashMapHolder<T>::m_objectMap;
 template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::IndexShard HashMapHolder<T>::s_Shards[HashMapHolder<T>::SHARD_COUNT];
+template <class T> std::mutex HashMapHolder<T>::s_RetireLock;
+template <class T> std::vector<std::pair<typename HashMapHolder<T>::IndexTable*, uint32>> HashMapHolder<T>::s_Retired;
+template <class T> uint32 HashMapHolder<T>::s_Epoch = 0;
 
 /// Global definitions for the hashmap storage
 
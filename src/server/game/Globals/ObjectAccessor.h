@@ -28,6 +28,9 @@ class Map;
 class WorldRunnable;
 class Transport;
 
+/// Global GUID index of one object type
+/// Find() is lock free : it probes a per shard open addressing table that writers only ever publish whole,
+/// the unordered_map + RW lock are kept for the (rare) full iterations
 template <class T>
 class HashMapHolder
 {
@@ -38,34 +41,244 @@ class HashMapHolder
 
         static void Insert(T* o)
         {
+            InsertIndex(o->GetGUID(), o);
+
             TRINITY_WRITE_GUARD(LockType, i_lock);
             m_objectMap[o->GetGUID()] = o;
         }
 
         static void Remove(T* o)
         {
+            RemoveIndex(o->GetGUID());
+
             TRINITY_WRITE_GUARD(LockType, i_lock);
             m_objectMap.erase(o->GetGUID());
         }
 
         static T* Find(uint64 guid)
         {
-            TRINITY_READ_GUARD(LockType, i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            uint64 l_Hash = HashGuid(guid);
+
+            IndexTable const* l_Table = s_Shards[l_Hash >> (64 - SHARD_BITS)].Table.load(std::memory_order_acquire);
+            if (!l_Table)
+                return NULL;
+
+            /// Tables are never more than half full, an empty slot always ends the probe
+            for (uint32 l_Slot = uint32(l_Hash) & l_Table->Mask;; l_Slot = (l_Slot + 1) & l_Table->Mask)
+            {
+                uint64 l_Guid = l_Table->Slots[l_Slot].Guid.load(std::memory_order_acquire);
+                if (l_Guid == guid)
+                    return l_Table->Slots[l_Slot].Object.load(std::memory_order_acquire);
+
+                if (!l_Guid)
+                    return NULL;
+            }
         }
 
         static MapType& GetContainer() { return m_objectMap; }
 
         static LockType* GetLock() { return &i_lock; }
 
+        /// Free the index tables replaced before the previous call, must be called when no map is updating
+        static void ReclaimRetired()
+        {
+            std::lock_guard<std::mutex> l_Guard(s_RetireLock);
+            ++s_Epoch;
+
+            for (typename std::vector<std::pair<IndexTable*, uint32>>::iterator l_Itr = s_Retired.begin(); l_Itr != s_Retired.end();)
+            {
+                if (l_Itr->second + 2 > s_Epoch)
+                {
+                    ++l_Itr;
+                    continue;
+                }
+
+                delete[] l_Itr->first->Slots;
+                delete l_Itr->first;
+                l_Itr = s_Retired.erase(l_Itr);
+            }
+        }
+
     private:
 
+        enum
+        {
+            SHARD_BITS          = 6,
+            SHARD_COUNT         = 1 << SHARD_BITS,
+            MIN_TABLE_CAPACITY  = 64
+        };
+
+        struct IndexSlot
+        {
+            std::atomic<uint64> Guid;       ///< 0 if the slot was never used, a removed object keeps its guid with a null Object
+            std::atomic<T*> Object;
+        };
+
+        /// Immutable once published, only the slots content changes
+        struct IndexTable
+        {
+            uint32 Mask;
+            IndexSlot* Slots;
+        };
+
+        /// One cache line per shard so writers of different shards never share a line
+        struct alignas(64) IndexShard
+        {
+            IndexShard() : Table(nullptr), Used(0), Live(0) { }
+
+            std::mutex Lock;
+            std::atomic<IndexTable*> Table;
+            uint32 Used;                    ///< Slots with a guid, removed ones included
+            uint32 Live;
+        };
+
         //Non instanceable only static
         HashMapHolder() {}
 
+        static uint64 HashGuid(uint64 p_Guid)
+        {
+            p_Guid ^= p_Guid >> 33;
+            p_Guid *= UI64LIT(0xFF51AFD7ED558CCD);
+            p_Guid ^= p_Guid >> 33;
+            p_Guid *= UI64LIT(0xC4CEB9FE1A85EC53);
+            p_Guid ^= p_Guid >> 33;
+            return p_Guid;
+        }
+
+        static void InsertIndex(uint64 p_Guid, T* p_Object)
+        {
+            if (!p_Guid)
+                return;
+
+            uint64 l_Hash = HashGuid(p_Guid);
+            IndexShard& l_Shard = s_Shards[l_Hash >> (64 - SHARD_BITS)];
+
+            std::lock_guard<std::mutex> l_Guard(l_Shard.Lock);
+
+            IndexTable* l_Table = l_Shard.Table.load(std::memory_order_relaxed);
+            if (!l_Table || (l_Shard.Used + 1) * 2 > l_Table->Mask + 1)
+                l_Table = RebuildIndex(l_Shard, l_Shard.Live + 1);
+
+            for (uint32 l_Slot = uint32(l_Hash) & l_Table->Mask;; l_Slot = (l_Slot + 1) & l_Table->Mask)
+            {
+                IndexSlot& l_IndexSlot = l_Table->Slots[l_Slot];
+                uint64 l_Guid = l_IndexSlot.Guid.load(std::memory_order_relaxed);
+
+                if (l_Guid == p_Guid)
+                {
+                    if (!l_IndexSlot.Object.load(std::memory_order_relaxed))
+                        ++l_Shard.Live;
+
+                    l_IndexSlot.Object.store(p_Object, std::memory_order_release);
+                    return;
+                }
+
+                if (!l_Guid)
+                {
+                    /// Object first, readers matching the guid must see it
+                    l_IndexSlot.Object.store(p_Object, std::memory_order_relaxed);
+                    l_IndexSlot.Guid.store(p_Guid, std::memory_order_release);
+                    ++l_Shard.Used;
+                    ++l_Shard.Live;
+                    return;
+                }
+            }
+        }
+
+        static void RemoveIndex(uint64 p_Guid)
+        {
+            if (!p_Guid)
+                return;
+
+            uint64 l_Hash = HashGuid(p_Guid);
+            IndexShard& l_Shard = s_Shards[l_Hash >> (64 - SHARD_BITS)];
+
+            std::lock_guard<std::mutex> l_Guard(l_Shard.Lock);
+
+            IndexTable* l_Table = l_Shard.Table.load(std::memory_order_relaxed);
+            if (!l_Table)
+                return;
+
+            for (uint32 l_Slot = uint32(l_Hash) & l_Table->Mask;; l_Slot = (l_Slot + 1) & l_Table->Mask)
+            {
+                IndexSlot& l_IndexSlot = l_Table->Slots[l_Slot];
+                uint64 l_Guid = l_IndexSlot.Guid.load(std::memory_order_relaxed);
+
+                if (!l_Guid)
+                    return;
+
+                if (l_Guid == p_Guid)
+                {
+                    if (l_IndexSlot.Object.load(std::memory_order_relaxed))
+                    {
+                        l_IndexSlot.Object.store(nullptr, std::memory_order_release);
+                        --l_Shard.Live;
+                    }
+                    return;
+                }
+            }
+        }
+
+        /// Copy the live entries in a new table sized for p_Count objects and publish it, shard lock must be held
+        static IndexTable* RebuildIndex(IndexShard& p_Shard, uint32 p_Count)
+        {
+            uint32 l_Capacity = MIN_TABLE_CAPACITY;
+            while (l_Capacity < p_Count * 4)
+                l_Capacity <<= 1;
+
+            IndexTable* l_NewTable = new IndexTable();
+            l_NewTable->Mask  = l_Capacity - 1;
+            l_NewTable->Slots = new IndexSlot[l_Capacity];
+
+            for (uint32 l_I = 0; l_I < l_Capacity; ++l_I)
+            {
+                l_NewTable->Slots[l_I].Guid.store(0, std::memory_order_relaxed);
+                l_NewTable->Slots[l_I].Object.store(nullptr, std::memory_order_relaxed);
+            }
+
+            p_Shard.Used = 0;
+
+            IndexTable* l_OldTable = p_Shard.Table.load(std::memory_order_relaxed);
+            if (l_OldTable)
+            {
+                for (uint32 l_I = 0; l_I <= l_OldTable->Mask; ++l_I)
+                {
+                    uint64 l_Guid = l_OldTable->Slots[l_I].Guid.load(std::memory_order_relaxed);
+                    T* l_Object   = l_OldTable->Slots[l_I].Object.load(std::memory_order_relaxed);
+                    if (!l_Guid || !l_Object)
+                        continue;
+
+                    uint32 l_Slot = uint32(HashGuid(l_Guid)) & l_NewTable->Mask;
+                    while (l_NewTable->Slots[l_Slot].Guid.load(std::memory_order_relaxed))
+                        l_Slot = (l_Slot + 1) & l_NewTable->Mask;
+
+                    l_NewTable->Slots[l_Slot].Guid.store(l_Guid, std::memory_order_relaxed);
+                    l_NewTable->Slots[l_Slot].Object.store(l_Object, std::memory_order_relaxed);
+                    ++p_Shard.Used;
+                }
+            }
+
+            p_Shard.Live = p_Shard.Used;
+            p_Shard.Table.store(l_NewTable, std::memory_order_release);
+
+            /// Readers may still probe the old table until the next quiescent point
+            if (l_OldTable)
+            {
+                std::lock_guard<std::mutex> l_Guard(s_RetireLock);
+                s_Retired.push_back(std::make_pair(l_OldTable, s_Epoch));
+            }
+
+            return l_NewTable;
+        }
+
         static LockType i_lock;
         static MapType  m_objectMap;
+
+        static IndexShard s_Shards[SHARD_COUNT];
+
+        static std::mutex s_RetireLock;
+        static std::vector<std::pair<IndexTable*, uint32>> s_Retired;   ///< Replaced table, epoch of the replacement
+        static uint32 s_Epoch;
 };
 
 class ObjectAccessor
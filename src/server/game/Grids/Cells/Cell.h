@@ -101,6 +101,10 @@ struct Cell
 
     static CellArea CalculateCellArea(float x, float y, float radius);
 
+    /// Cells reached by Visit() around x, y, a batched sweep uses it to filter the cells of each of its sources
+    static CellArea CalculateVisitArea(float x, float y, float radius);
+    static bool IsInVisitArea(CellArea const& area, CellCoord const& cell);
+
 private:
     template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, CellCoord const&, CellCoord const&) const;
 };
@@ -49,6 +49,32 @@ inline CellArea Cell::CalculateCellArea(float x, float y, float radius)
     return CellArea(centerX, centerY);
 }
 
+inline CellArea Cell::CalculateVisitArea(float x, float y, float radius)
+{
+    return CalculateCellArea(x, y, std::min(radius, float(SIZE_OF_GRIDS)));
+}
+
+inline bool Cell::IsInVisitArea(CellArea const& area, CellCoord const& cell)
+{
+    if (cell.x_coord < area.low_bound.x_coord || cell.x_coord > area.high_bound.x_coord ||
+        cell.y_coord < area.low_bound.y_coord || cell.y_coord > area.high_bound.y_coord)
+        return false;
+
+    //small areas are visited as a whole
+    if ((area.high_bound.x_coord <= (area.low_bound.x_coord + 4)) || (area.high_bound.y_coord <= (area.low_bound.y_coord + 4)))
+        return true;
+
+    //same octagon as VisitCircle()
+    uint32 x_shift = (uint32)ceilf((area.high_bound.x_coord - area.low_bound.x_coord) * 0.3f - 0.5f);
+    uint32 x_start = area.low_bound.x_coord + x_shift;
+    uint32 x_end = area.high_bound.x_coord - x_shift;
+    if (cell.x_coord >= x_start && cell.x_coord <= x_end)
+        return true;
+
+    uint32 step = cell.x_coord < x_start ? x_start - cell.x_coord : cell.x_coord - x_end;
+    return cell.y_coord >= area.low_bound.y_coord + step && cell.y_coord + step <= area.high_bound.y_coord;
+}
+
 template<class T, class CONTAINER>
 inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T, CONTAINER>& visitor, Map& map, float radius, float x_off, float y_off) const
 {
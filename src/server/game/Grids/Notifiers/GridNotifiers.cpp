@@ -149,6 +149,46 @@ void AIRelocationNotifier::Visit(CreatureMapType &m)
     }
 }
 
+template<class T> void BatchedVisibleChangesNotifier::VisitSources(GridRefManager<T> &m)
+{
+    for (BatchedNotifierSourceList::const_iterator itr = i_sources.begin(); itr != i_sources.end(); ++itr)
+    {
+        // a previous source may have removed it (MoveInLineOfSight, ...)
+        if (!itr->i_unit->IsInWorld() || !Cell::IsInVisitArea(itr->i_area, i_cell))
+            continue;
+
+        VisibleChangesNotifier notifier(*itr->i_unit);
+        notifier.Visit(m);
+    }
+}
+
+void BatchedVisibleChangesNotifier::Visit(PlayerMapType &m)
+{
+    VisitSources(m);
+}
+
+void BatchedVisibleChangesNotifier::Visit(CreatureMapType &m)
+{
+    VisitSources(m);
+}
+
+void BatchedVisibleChangesNotifier::Visit(DynamicObjectMapType &m)
+{
+    VisitSources(m);
+}
+
+void BatchedAIRelocationNotifier::Visit(CreatureMapType &m)
+{
+    for (BatchedNotifierSourceList::const_iterator itr = i_sources.begin(); itr != i_sources.end(); ++itr)
+    {
+        if (!itr->i_unit->IsInWorld() || !Cell::IsInVisitArea(itr->i_area, i_cell))
+            continue;
+
+        AIRelocationNotifier notifier(*itr->i_unit);
+        notifier.Visit(m);
+    }
+}
+
 void MessageDistDeliverer::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -91,6 +91,47 @@ namespace JadeCore
         void Visit(CreatureMapType &);
     };
 
+    /// Unit of a batched sweep with the cells its own Cell::Visit would have reached
+    struct BatchedNotifierSource
+    {
+        BatchedNotifierSource(Unit* unit, CellCoord const& cell, CellArea const& area) : i_unit(unit), i_cell(cell), i_area(area) {}
+
+        Unit* i_unit;
+        CellCoord i_cell;                               ///< Standing cell, sources are grouped by it
+        CellArea i_area;
+    };
+
+    typedef std::vector<BatchedNotifierSource> BatchedNotifierSourceList;
+
+    /// VisibleChangesNotifier of several units, each visited cell is walked once for all of them
+    struct BatchedVisibleChangesNotifier
+    {
+        BatchedNotifierSourceList const& i_sources;
+        CellCoord i_cell;
+
+        explicit BatchedVisibleChangesNotifier(BatchedNotifierSourceList const& sources) : i_sources(sources), i_cell(0, 0) {}
+        void SetCell(CellCoord const& cell) { i_cell = cell; }
+        template<class T> void Visit(GridRefManager<T> &) {}
+        void Visit(PlayerMapType &);
+        void Visit(CreatureMapType &);
+        void Visit(DynamicObjectMapType &);
+
+        private:
+            template<class T> void VisitSources(GridRefManager<T> &);
+    };
+
+    /// AIRelocationNotifier of several units, each visited cell is walked once for all of them
+    struct BatchedAIRelocationNotifier
+    {
+        BatchedNotifierSourceList const& i_sources;
+        CellCoord i_cell;
+
+        explicit BatchedAIRelocationNotifier(BatchedNotifierSourceList const& sources) : i_sources(sources), i_cell(0, 0) {}
+        void SetCell(CellCoord const& cell) { i_cell = cell; }
+        template<class T> void Visit(GridRefManager<T> &) {}
+        void Visit(CreatureMapType &);
+    };
+
     struct GridUpdater
     {
         GridType &i_grid;
@@ -134,6 +175,7 @@ namespace JadeCore
         uint32 team;
         Player const* skipped_receiver;
         GuidUnorderedSet m_IgnoredGUIDs;
+        SharedWorldPacket m_SharedMessage;     ///< Built on first delivery, every receiver shares the same payload
         MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, Player const* skipped = NULL, GuidUnorderedSet p_IgnoredSet = GuidUnorderedSet())
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->IsPlayer()) ? ((Player*)src)->GetTeam() : 0)
@@ -159,7 +201,12 @@ namespace JadeCore
                 return;
 
             if (WorldSession* session = player->GetSession())
-                session->SendPacket(i_message);
+            {
+                if (!m_SharedMessage)
+                    m_SharedMessage = i_message->Share();
+
+                session->SendSharedPacket(m_SharedMessage);
+            }
         }
     };
 
@@ -169,6 +216,7 @@ namespace JadeCore
         WorldPacket* i_message;
         uint32 i_phaseMask;
         float i_distSq;
+        SharedWorldPacket m_SharedMessage;     ///< Built on first delivery, every receiver shares the same payload
         UnfriendlyMessageDistDeliverer(Unit* src, WorldPacket* msg, float dist)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist) { }
 
@@ -185,7 +233,12 @@ namespace JadeCore
                 return;
 
             if (WorldSession* session = player->GetSession())
-                session->SendPacket(i_message);
+            {
+                if (!m_SharedMessage)
+                    m_SharedMessage = i_message->Share();
+
+                session->SendSharedPacket(m_SharedMessage);
+            }
 
             if (i_message->GetOpcode() == SMSG_CLEAR_TARGET)
             {
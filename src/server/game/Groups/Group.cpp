@@ -1960,6 +1960,8 @@ void Group::BroadcastAddonMessagePacket(WorldPacket* packet, const std::string&
 
 void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int group, uint64 ignore)
 {
+    SharedWorldPacket l_SharedPacket;
+
     for (GroupReference* itr = GetFirstMember(); itr != NULL; itr = itr->next())
     {
         Player* player = itr->getSource();
@@ -1967,7 +1969,12 @@ void Group::BroadcastPacket(WorldPacket* packet, bool ignorePlayersInBGRaid, int
             continue;
 
         if (player->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            player->GetSession()->SendPacket(packet);
+        {
+            if (!l_SharedPacket)
+                l_SharedPacket = packet->Share();
+
+            player->GetSession()->SendSharedPacket(l_SharedPacket);
+        }
     }
 }
 
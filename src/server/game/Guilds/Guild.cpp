@@ -1267,16 +1267,20 @@ void Guild::HandleRoster(WorldSession* p_Session /*= NULL*/)
 
         l_Data << float(l_Player ? 0.0f : float(::time(NULL) - l_Member->GetLogoutTime()) / DAY);       ///< Last Save
 
+        /// The member may be updated by another map thread, its skills are read from the snapshot
+        PlayerKnowledgeSnapshotPtr l_Knowledge = l_Player ? l_Player->GetKnowledgeSnapshot() : PlayerKnowledgeSnapshotPtr();
+
         /// For (2 professions)
         for (int l_I = 0; l_I < 2; ++l_I)
         {
             uint32 l_ProfessionID = l_Player ? l_Player->GetUInt32Value(PLAYER_FIELD_PROFESSION_SKILL_LINE + l_I) : 0;
+            PlayerKnowledgeSnapshot::Skill const* l_Skill = (l_ProfessionID && l_Knowledge) ? l_Knowledge->GetSkill(l_ProfessionID) : nullptr;
 
-            if (l_ProfessionID)
+            if (l_Skill)
             {
                 l_Data << uint32(l_ProfessionID);                                                       ///< Db ID
-                l_Data << uint32(l_Player->GetSkillValue(l_ProfessionID));                              ///< Rank
-                l_Data << uint32(l_Player->GetSkillStep(l_ProfessionID));                               ///< Step
+                l_Data << uint32(l_Skill->Value);                                                       ///< Rank
+                l_Data << uint32(l_Skill->Step);                                                        ///< Step
             }
             else
             {
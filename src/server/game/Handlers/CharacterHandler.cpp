@@ -938,8 +938,9 @@ void WorldSession::LoginPlayer(uint64 p_Guid)
         return;
     }
 
-    m_CharacterLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)l_LoginQueryHolder);
-    m_CharacterLoginDBCallback = LoginDatabase.DelayQueryHolder((SQLQueryHolder*)l_LoginDBQueryHolder);
+    /// Same ordering keys as Player::SaveToDB, the login reads must not overtake a pending save
+    m_CharacterLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)l_LoginQueryHolder, GUID_LOPART(p_Guid));
+    m_CharacterLoginDBCallback = LoginDatabase.DelayQueryHolder((SQLQueryHolder*)l_LoginDBQueryHolder, GetAccountId());
 }
 
 
@@ -1527,7 +1528,7 @@ void WorldSession::HandleCharRenameOpcode(WorldPacket& p_RecvData)
     stmt->setString(4, newName);
     stmt->setString(5, newName);
 
-    _charRenameCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    _charRenameCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, GUID_LOPART(l_Guid)));
 }
 
 void WorldSession::BuildCharacterRename(WorldPacket* p_Packet, ObjectGuid p_Guid, uint8 p_Result, std::string p_Name)
@@ -1567,14 +1568,14 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult resu
     stmt->setUInt16(1, AT_LOGIN_RENAME);
     stmt->setUInt32(2, guidLow);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guidLow);
 
     // Removed declined name from db
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
 
     stmt->setUInt32(0, guidLow);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guidLow);
 
     // Logging
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_NAME_LOG);
@@ -1583,7 +1584,7 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult resu
     stmt->setString(1, oldName);
     stmt->setString(2, newName);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guidLow);
 
     sLog->outInfo(LOG_FILTER_CHARACTER, "Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldName.c_str(), guidLow, newName.c_str());
 
@@ -1647,7 +1648,7 @@ void WorldSession::HandleSetPlayerDeclinedNames(WorldPacket& p_RecvData)
     for (int l_I = 0; l_I < MAX_DECLINED_NAME_CASES; ++l_I)
         CharacterDatabase.EscapeString(l_DeclinedName.name[l_I]);
 
-    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction(GUID_LOPART(l_Player));
 
     PreparedStatement* l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_DECLINED_NAME);
     l_Statement->setUInt32(0, GUID_LOPART(l_Player));
@@ -1892,13 +1893,13 @@ void WorldSession::HandleCharCustomize(WorldPacket& p_RecvData)
     l_Statement->setUInt16(1, uint16(AT_LOGIN_CUSTOMIZE));
     l_Statement->setUInt32(2, GUID_LOPART(l_PlayerGuid));
 
-    CharacterDatabase.Execute(l_Statement);
+    CharacterDatabase.Execute(l_Statement, GUID_LOPART(l_PlayerGuid));
 
     l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
 
     l_Statement->setUInt32(0, GUID_LOPART(l_PlayerGuid));
 
-    CharacterDatabase.Execute(l_Statement);
+    CharacterDatabase.Execute(l_Statement, GUID_LOPART(l_PlayerGuid));
 
     sWorld->UpdateCharacterInfo(GUID_LOPART(l_PlayerGuid), l_NewName, l_CharacterGender);
 
@@ -2291,7 +2292,7 @@ void WorldSession::HandleCharRaceOrFactionChange(WorldPacket& p_Packet)
 
     CharacterDatabase.EscapeString(l_Name);
     Player::Customize(l_Guid, l_SexID, l_SkinID, l_FaceID, l_HairStyleID, l_HairColor, l_FacialHairStyleID);
-    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction();
+    SQLTransaction l_Transaction = CharacterDatabase.BeginTransaction(GUID_LOPART(l_Guid));
 
     l_Statement = CharacterDatabase.GetPreparedStatement(CHAR_UPD_FACTION_OR_RACE);
     l_Statement->setString(0, l_Name);
@@ -222,7 +222,7 @@ _creatureToMoveLock(false), _gameObjectsToMoveLock(false), i_mapEntry(sMapStore.
 i_spawnMode(SpawnMode), i_InstanceId(InstanceId), m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsGameObjectUpdateIter(_transportsGameObject.end()), _transportsUpdateIter(_transports.end()),
-i_gridExpiry(expiry), i_scriptLock(false)
+i_gridExpiry(expiry), i_scriptLock(false), m_LastUpdateCost(0), m_AINotifyTimer(0)
 {
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -715,6 +715,8 @@ void Map::Update(const uint32 t_diff)
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
 
+    ProcessVisibilityUpdates(t_diff);
+
     sScriptMgr->OnMapUpdate(this, t_diff);
 
 #ifdef CROSS
@@ -722,6 +724,174 @@ void Map::Update(const uint32 t_diff)
 #endif
 }
 
+void Map::ScheduleVisibilityUpdate(Unit* p_Unit)
+{
+    if (p_Unit->IsVisibilityUpdateScheduled())
+        return;
+
+    p_Unit->SetVisibilityUpdateScheduled(true);
+    p_Unit->SetVisibilityUpdateSlot(m_VisibilityUpdateQueue.size());
+    m_VisibilityUpdateQueue.push_back(p_Unit);
+}
+
+void Map::ScheduleAINotify(Unit* p_Unit)
+{
+    if (p_Unit->IsAINotifyScheduled())
+        return;
+
+    p_Unit->SetAINotifyScheduled(true);
+    p_Unit->SetAINotifySlot(m_AINotifyQueue.size());
+    m_AINotifyQueue.push_back(p_Unit);
+}
+
+/// A scheduled unit is either in the queue or, while it is processed, in the batch it was swapped to, at the same position
+static void CancelScheduledUnit(std::vector<Unit*>& p_Queue, std::vector<Unit*>& p_Batch, uint32 p_Slot, Unit* p_Unit)
+{
+    if (p_Slot < p_Queue.size() && p_Queue[p_Slot] == p_Unit)
+        p_Queue[p_Slot] = nullptr;
+    else if (p_Slot < p_Batch.size() && p_Batch[p_Slot] == p_Unit)
+        p_Batch[p_Slot] = nullptr;
+}
+
+void Map::CancelVisibilityUpdates(Unit* p_Unit)
+{
+    if (p_Unit->IsVisibilityUpdateScheduled())
+        CancelScheduledUnit(m_VisibilityUpdateQueue, m_VisibilityUpdateBatch, p_Unit->GetVisibilityUpdateSlot(), p_Unit);
+
+    if (p_Unit->IsAINotifyScheduled())
+        CancelScheduledUnit(m_AINotifyQueue, m_AINotifyBatch, p_Unit->GetAINotifySlot(), p_Unit);
+
+    p_Unit->SetVisibilityUpdateScheduled(false);
+    p_Unit->SetAINotifyScheduled(false);
+}
+
+/// Sources standing in the same cell share one walk over the union of their cell areas
+template<class NOTIFIER>
+static void VisitBatchedSources(Map& p_Map, JadeCore::BatchedNotifierSourceList& p_Sources, bool p_GridObjects)
+{
+    std::sort(p_Sources.begin(), p_Sources.end(), [](JadeCore::BatchedNotifierSource const& p_A, JadeCore::BatchedNotifierSource const& p_B) -> bool
+    {
+        return p_A.i_cell.GetId() < p_B.i_cell.GetId();
+    });
+
+    JadeCore::BatchedNotifierSourceList l_Group;
+    for (size_t l_Begin = 0; l_Begin < p_Sources.size();)
+    {
+        size_t l_End = l_Begin;
+        CellArea l_Area = p_Sources[l_Begin].i_area;
+
+        l_Group.clear();
+        for (; l_End < p_Sources.size() && p_Sources[l_End].i_cell == p_Sources[l_Begin].i_cell; ++l_End)
+        {
+            CellArea const& l_SourceArea = p_Sources[l_End].i_area;
+            l_Area.low_bound.x_coord  = std::min(l_Area.low_bound.x_coord, l_SourceArea.low_bound.x_coord);
+            l_Area.low_bound.y_coord  = std::min(l_Area.low_bound.y_coord, l_SourceArea.low_bound.y_coord);
+            l_Area.high_bound.x_coord = std::max(l_Area.high_bound.x_coord, l_SourceArea.high_bound.x_coord);
+            l_Area.high_bound.y_coord = std::max(l_Area.high_bound.y_coord, l_SourceArea.high_bound.y_coord);
+            l_Group.push_back(p_Sources[l_End]);
+        }
+
+        l_Begin = l_End;
+
+        NOTIFIER l_Notifier(l_Group);
+        TypeContainerVisitor<NOTIFIER, WorldTypeMapContainer> l_WorldVisitor(l_Notifier);
+        TypeContainerVisitor<NOTIFIER, GridTypeMapContainer> l_GridVisitor(l_Notifier);
+
+        for (uint32 l_X = l_Area.low_bound.x_coord; l_X <= l_Area.high_bound.x_coord; ++l_X)
+        {
+            for (uint32 l_Y = l_Area.low_bound.y_coord; l_Y <= l_Area.high_bound.y_coord; ++l_Y)
+            {
+                CellCoord l_CellCoord(l_X, l_Y);
+
+                bool l_Reached = false;
+                for (JadeCore::BatchedNotifierSource const& l_Source : l_Group)
+                {
+                    if (Cell::IsInVisitArea(l_Source.i_area, l_CellCoord))
+                    {
+                        l_Reached = true;
+                        break;
+                    }
+                }
+
+                if (!l_Reached)
+                    continue;
+
+                Cell l_Cell(l_CellCoord);
+                l_Cell.SetNoCreate();
+                l_Notifier.SetCell(l_CellCoord);
+
+                p_Map.Visit(l_Cell, l_WorldVisitor);
+                if (p_GridObjects)
+                    p_Map.Visit(l_Cell, l_GridVisitor);
+            }
+        }
+    }
+}
+
+void Map::ProcessVisibilityUpdates(uint32 p_Diff)
+{
+    JadeCore::BatchedNotifierSourceList l_Sources;
+
+    /// Units that moved enough since their last notify are shown to / hidden from nearby players in one pass
+    if (!m_VisibilityUpdateQueue.empty())
+    {
+        m_VisibilityUpdateBatch.swap(m_VisibilityUpdateQueue);
+
+        for (size_t l_I = 0; l_I < m_VisibilityUpdateBatch.size(); ++l_I)
+        {
+            Unit* l_Unit = m_VisibilityUpdateBatch[l_I];
+            if (!l_Unit)
+                continue;
+
+            l_Unit->SetVisibilityUpdateScheduled(false);
+
+            if (!l_Unit->IsInWorld() || l_Unit->GetMap() != this)
+                continue;
+
+            if (!l_Unit->UpdateVisibilityIfMoved())
+                continue;
+
+            l_Sources.push_back(JadeCore::BatchedNotifierSource(l_Unit, JadeCore::ComputeCellCoord(l_Unit->GetPositionX(), l_Unit->GetPositionY()),
+                Cell::CalculateVisitArea(l_Unit->GetPositionX(), l_Unit->GetPositionY(), l_Unit->GetVisibilityRange())));
+        }
+
+        m_VisibilityUpdateBatch.clear();
+
+        if (!l_Sources.empty())
+            VisitBatchedSources<JadeCore::BatchedVisibleChangesNotifier>(*this, l_Sources, false);
+    }
+
+    m_AINotifyTimer += p_Diff;
+    if (m_AINotifyTimer < World::Visibility_AINotifyDelay || m_AINotifyQueue.empty())
+        return;
+
+    m_AINotifyTimer = 0;
+
+    /// MoveInLineOfSight of the creatures around every unit that moved since the last notify
+    m_AINotifyBatch.swap(m_AINotifyQueue);
+    l_Sources.clear();
+
+    for (size_t l_I = 0; l_I < m_AINotifyBatch.size(); ++l_I)
+    {
+        Unit* l_Unit = m_AINotifyBatch[l_I];
+        if (!l_Unit)
+            continue;
+
+        l_Unit->SetAINotifyScheduled(false);
+
+        if (!l_Unit->IsInWorld() || l_Unit->GetMap() != this)
+            continue;
+
+        l_Sources.push_back(JadeCore::BatchedNotifierSource(l_Unit, JadeCore::ComputeCellCoord(l_Unit->GetPositionX(), l_Unit->GetPositionY()),
+            Cell::CalculateVisitArea(l_Unit->GetPositionX(), l_Unit->GetPositionY(), 60.0f)));
+    }
+
+    m_AINotifyBatch.clear();
+
+    if (!l_Sources.empty())
+        VisitBatchedSources<JadeCore::BatchedAIRelocationNotifier>(*this, l_Sources, true);
+}
+
 void Map::RemovePlayerFromMap(Player* player, bool remove)
 {
     player->RemoveFromWorld();
@@ -2605,8 +2775,13 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    if (m_mapRefManager.isEmpty())
+        return;
+
+    SharedWorldPacket l_SharedData = data->Share();
+
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->getSource()->GetSession()->SendPacket(data);
+        itr->getSource()->GetSession()->SendSharedPacket(l_SharedData);
 }
 
 bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
@@ -263,6 +263,16 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<JadeCore::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<JadeCore::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
 
+        /// Used by MapUpdater to dispatch the heaviest maps first
+        uint32 GetLastUpdateCost() const { return m_LastUpdateCost; }
+        void SetLastUpdateCost(uint32 p_Cost) { m_LastUpdateCost = p_Cost; }
+
+        /// Units are gathered and notified once per update instead of running their own events
+        /// Visibility changes are sent every update, MoveInLineOfSight every Visibility.AINotifyDelay
+        void ScheduleVisibilityUpdate(Unit* p_Unit);
+        void ScheduleAINotify(Unit* p_Unit);
+        void CancelVisibilityUpdates(Unit* p_Unit);
+
         float GetVisibilityRange() const
         {
             ///< Hack fixes...
@@ -578,6 +588,8 @@ class Map : public GridRefManager<NGridType>
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
 
+        void ProcessVisibilityUpdates(uint32 p_Diff);
+
     protected:
 
         void SetUnloadReferenceLock(const GridCoord &p, bool on)
@@ -641,6 +653,13 @@ class Map : public GridRefManager<NGridType>
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
         bool i_scriptLock;
+        uint32 m_LastUpdateCost;                            ///< Duration of the last Update call in microseconds
+
+        std::vector<Unit*> m_VisibilityUpdateQueue;
+        std::vector<Unit*> m_VisibilityUpdateBatch;         ///< Queue being processed, removed units are set to nullptr
+        std::vector<Unit*> m_AINotifyQueue;
+        std::vector<Unit*> m_AINotifyBatch;
+        uint32 m_AINotifyTimer;
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
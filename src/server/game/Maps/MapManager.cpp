@@ -51,7 +51,15 @@ void MapManager::Initialize()
     int num_threads(sWorld->getIntConfig(CONFIG_NUMTHREADS));
     // Start mtmaps if needed.
     if (num_threads > 0)
+    {
+        m_updater.SetThreadAffinity(sWorld->getBoolConfig(CONFIG_MAP_UPDATE_THREAD_AFFINITY));
         m_updater.activate(num_threads);
+
+        /// Heavy maps (continents, capital cities) always updated by the same worker
+        Tokenizer l_PinnedMaps(ConfigMgr::GetStringDefault("MapUpdate.PinnedMaps", ""), ',');
+        for (Tokenizer::const_iterator l_Iter = l_PinnedMaps.begin(); l_Iter != l_PinnedMaps.end(); ++l_Iter)
+            m_updater.PinMap(uint32(atol(*l_Iter)));
+    }
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -270,16 +278,16 @@ void MapManager::Update(uint32 diff)
     /// - Start Achievement criteria update processing thread
     sAchievementMgr->PrepareCriteriaUpdateTaskThread();
 
-    for (auto l_PlayerTask : sAchievementMgr->GetPlayersCriteriaTask())
+    for (auto& l_PlayerTask : sAchievementMgr->GetPlayersCriteriaTask())
     {
         if (m_updater.activated())
-            m_updater.schedule_specific(new AchievementCriteriaUpdateRequest(&m_updater, l_PlayerTask.second));
+            m_updater.schedule_specific(sAchievementMgr->AcquireCriteriaUpdateRequest(&m_updater, l_PlayerTask.second));
         else
         {
             /// Process all task in synchrone way
-            auto l_Task = new AchievementCriteriaUpdateRequest(nullptr, l_PlayerTask.second);
+            auto l_Task = sAchievementMgr->AcquireCriteriaUpdateRequest(nullptr, l_PlayerTask.second);
             l_Task->call();
-            delete l_Task;
+            l_Task->Release();
         }
     }
 
@@ -7,10 +7,24 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <condition_variable>
+#include <chrono>
 
 #include "Common.h"
 #include "MapUpdater.h"
 #include "Map.h"
+#include "PerfProfiler.h"
+
+#if PLATFORM == PLATFORM_WINDOWS
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+/// Index of the worker running on the current thread, -1 outside of the pool
+static thread_local int32 s_WorkerIndex = -1;
+/// Updater owning the current worker thread
+static thread_local MapUpdater* s_WorkerUpdater = nullptr;
 
 /// Constructor
 MapUpdaterTask::MapUpdaterTask(MapUpdater* p_Updater)
@@ -34,52 +48,117 @@ void MapUpdaterTask::UpdateFinished()
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 
-class MapUpdateRequest : MapUpdaterTask
+class MapUpdateRequest : public MapUpdaterTask
 {
     private:
-        Map& m_map;
+        Map* m_map;
         uint32 m_diff;
 
     public:
-        MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : MapUpdaterTask(&u), m_map(m), m_diff(d)
+        MapUpdateRequest(MapUpdater& u)
+            : MapUpdaterTask(&u), m_map(nullptr), m_diff(0)
+        {
+        }
+
+        void Reset(Map* p_Map, uint32 p_Diff)
         {
+            m_map  = p_Map;
+            m_diff = p_Diff;
         }
 
         void call() override
         {
-            m_map.Update (m_diff);
+            auto l_Start = std::chrono::steady_clock::now();
+
+            m_map->Update(m_diff);
+
+            /// Measured cost is used to order the next tick dispatch
+            uint32 l_Cost = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_Start).count());
+            m_map->SetLastUpdateCost(l_Cost);
+
+            if (sPerfProfiler->IsEnabled())
+                sPerfProfiler->Record(PERF_CATEGORY_MAP, (uint64(m_map->GetId()) << 32) | m_map->GetInstanceId(), l_Cost);
+
             UpdateFinished();
         }
+
+        uint32 GetCost() const override
+        {
+            return m_map->GetLastUpdateCost();
+        }
+
+        uint32 GetPinnedMapId() const override
+        {
+            return m_map->GetId();
+        }
+
+        char const* GetName() const override
+        {
+            return "MapUpdate";
+        }
+
+        void Release() override
+        {
+            m_updater->ReleaseRequest(this);
+        }
 };
 
+//////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////
+
+MapUpdater::~MapUpdater()
+{
+    for (MapUpdateRequest* l_Request : _requestPool)
+        delete l_Request;
+
+    for (WorkerQueue* l_Queue : _workerQueues)
+        delete l_Queue;
+}
+
 void MapUpdater::activate(size_t num_threads)
 {
     for (size_t i = 0; i < num_threads; ++i)
-    {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
-    }
+        _workerQueues.push_back(new WorkerQueue());
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
     wait();
 
-    _queue.Cancel();
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _cancelationToken = true;
+    }
+
+    _workCondition.notify_all();
 
     for (auto& thread : _workerThreads)
     {
         thread.join();
     }
+
+    _workerThreads.clear();
+}
+
+void MapUpdater::PinMap(uint32 p_MapId)
+{
+    if (_workerQueues.empty() || _pinnedMaps.find(p_MapId) != _pinnedMaps.end())
+        return;
+
+    size_t l_Worker = _pinnedMaps.size() % _workerQueues.size();
+    _pinnedMaps[p_MapId] = l_Worker;
 }
 
 void MapUpdater::wait()
 {
+    DispatchBatch();
+
     std::unique_lock<std::mutex> lock(_lock);
 
-    while (pending_requests > 0)
+    while (_pendingRequests > 0)
         _condition.wait(lock);
 
     lock.unlock();
@@ -87,20 +166,22 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    ++pending_requests;
-
-    _queue.Push((MapUpdaterTask*)new MapUpdateRequest(map, *this, diff));
+    schedule_specific(AcquireRequest(map, diff));
 }
 
 void MapUpdater::schedule_specific(MapUpdaterTask* p_Request)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    ++_pendingRequests;
 
-    ++pending_requests;
+    /// Tasks scheduled from a worker (instances of a MapInstanced) go straight to its own queue
+    if (s_WorkerUpdater == this && s_WorkerIndex >= 0)
+    {
+        Dispatch(p_Request, size_t(s_WorkerIndex));
+        return;
+    }
 
-    _queue.Push(p_Request);
+    std::lock_guard<std::mutex> lock(_batchLock);
+    _batch.push_back(p_Request);
 }
 
 bool MapUpdater::activated()
@@ -110,26 +191,227 @@ bool MapUpdater::activated()
 
 void MapUpdater::update_finished()
 {
+    if (--_pendingRequests != 0)
+        return;
+
     std::lock_guard<std::mutex> lock(_lock);
+    _condition.notify_all();
+}
 
-    --pending_requests;
+void MapUpdater::Dispatch(MapUpdaterTask* p_Task, size_t p_Worker)
+{
+    bool l_Pinned = false;
 
-    _condition.notify_all();
+    if (uint32 l_MapId = p_Task->GetPinnedMapId())
+    {
+        auto l_Itr = _pinnedMaps.find(l_MapId);
+        if (l_Itr != _pinnedMaps.end())
+        {
+            p_Worker = l_Itr->second;
+            l_Pinned = true;
+        }
+    }
+
+    WorkerQueue& l_Queue = *_workerQueues[p_Worker];
+
+    {
+        std::lock_guard<std::mutex> lock(l_Queue.Lock);
+
+        if (l_Pinned)
+        {
+            l_Queue.Pinned.push_back(p_Task);
+            ++l_Queue.PinnedCount;
+        }
+        else
+        {
+            uint32 l_Cost = p_Task->GetCost();
+            auto l_Pos = std::upper_bound(l_Queue.Tasks.begin(), l_Queue.Tasks.end(), l_Cost, [](uint32 p_Cost, MapUpdaterTask const* p_Other) -> bool
+            {
+                return p_Cost < p_Other->GetCost();
+            });
+
+            l_Queue.Tasks.insert(l_Pos, p_Task);
+            ++_queuedTasks;
+        }
+    }
+
+    /// Acquiring the lock before notifying prevents a worker from missing the wake up
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (l_Pinned)
+        _workCondition.notify_all();
+    else
+        _workCondition.notify_one();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::DispatchBatch()
 {
-    while (1)
+    std::vector<MapUpdaterTask*> l_Batch;
+
+    {
+        std::lock_guard<std::mutex> lock(_batchLock);
+        l_Batch.swap(_batch);
+    }
+
+    if (l_Batch.empty() || _workerQueues.empty())
+        return;
+
+    /// Longest processing time first : heaviest tasks (last tick cost) are dispatched first, each one
+    /// on the worker with the lowest assigned cost, so the tick lasts about as long as the heaviest map
+    std::stable_sort(l_Batch.begin(), l_Batch.end(), [](MapUpdaterTask const* p_Left, MapUpdaterTask const* p_Right) -> bool
+    {
+        return p_Left->GetCost() > p_Right->GetCost();
+    });
+
+    std::vector<uint64> l_AssignedCost(_workerQueues.size(), 0);
+
+    for (MapUpdaterTask* l_Task : l_Batch)
+    {
+        size_t l_Worker = 0;
+
+        auto l_Pinned = _pinnedMaps.find(l_Task->GetPinnedMapId());
+        if (l_Pinned != _pinnedMaps.end())
+            l_Worker = l_Pinned->second;
+        else
+        {
+            for (size_t l_I = 1; l_I < l_AssignedCost.size(); ++l_I)
+            {
+                if (l_AssignedCost[l_I] < l_AssignedCost[l_Worker])
+                    l_Worker = l_I;
+            }
+        }
+
+        /// Unknown costs still count as one so light tasks are spread evenly
+        l_AssignedCost[l_Worker] += std::max<uint32>(l_Task->GetCost(), 1);
+
+        Dispatch(l_Task, l_Worker);
+    }
+}
+
+MapUpdaterTask* MapUpdater::PopTask(size_t p_Worker)
+{
+    WorkerQueue& l_Queue = *_workerQueues[p_Worker];
+
+    {
+        std::lock_guard<std::mutex> lock(l_Queue.Lock);
+
+        if (!l_Queue.Pinned.empty())
+        {
+            MapUpdaterTask* l_Task = l_Queue.Pinned.front();
+            l_Queue.Pinned.pop_front();
+            --l_Queue.PinnedCount;
+            return l_Task;
+        }
+
+        if (!l_Queue.Tasks.empty())
+        {
+            MapUpdaterTask* l_Task = l_Queue.Tasks.back();
+            l_Queue.Tasks.pop_back();
+            --_queuedTasks;
+            return l_Task;
+        }
+    }
+
+    return StealTask(p_Worker);
+}
+
+MapUpdaterTask* MapUpdater::StealTask(size_t p_Thief)
+{
+    if (_queuedTasks <= 0)
+        return nullptr;
+
+    size_t l_Count = _workerQueues.size();
+
+    for (size_t l_I = 1; l_I < l_Count; ++l_I)
+    {
+        WorkerQueue& l_Victim = *_workerQueues[(p_Thief + l_I) % l_Count];
+
+        std::lock_guard<std::mutex> lock(l_Victim.Lock);
+
+        if (l_Victim.Tasks.empty())
+            continue;
+
+        /// Take the heaviest task the victim has not started yet, that's the one delaying the tick
+        MapUpdaterTask* l_Task = l_Victim.Tasks.back();
+        l_Victim.Tasks.pop_back();
+        --_queuedTasks;
+        return l_Task;
+    }
+
+    return nullptr;
+}
+
+MapUpdateRequest* MapUpdater::AcquireRequest(Map& p_Map, uint32 p_Diff)
+{
+    MapUpdateRequest* l_Request = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(_poolLock);
+
+        if (!_requestPool.empty())
+        {
+            l_Request = _requestPool.back();
+            _requestPool.pop_back();
+        }
+    }
+
+    if (l_Request == nullptr)
+        l_Request = new MapUpdateRequest(*this);
+
+    l_Request->Reset(&p_Map, p_Diff);
+    return l_Request;
+}
+
+void MapUpdater::ReleaseRequest(MapUpdateRequest* p_Request)
+{
+    p_Request->Reset(nullptr, 0);
+
+    std::lock_guard<std::mutex> lock(_poolLock);
+    _requestPool.push_back(p_Request);
+}
+
+void MapUpdater::WorkerThread(size_t p_Index)
+{
+    s_WorkerIndex   = int32(p_Index);
+    s_WorkerUpdater = this;
+
+    if (_threadAffinity)
     {
-        MapUpdaterTask* request = nullptr;
+        uint32 l_Core = uint32(p_Index % std::max<uint32>(std::thread::hardware_concurrency(), 1));
+
+#if PLATFORM == PLATFORM_WINDOWS
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << l_Core);
+#elif defined(__linux__)
+        cpu_set_t l_CpuSet;
+        CPU_ZERO(&l_CpuSet);
+        CPU_SET(l_Core, &l_CpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(l_CpuSet), &l_CpuSet);
+#endif
+    }
 
-        _queue.WaitAndPop(request);
+    WorkerQueue& l_Queue = *_workerQueues[p_Index];
 
+    while (1)
+    {
         if (_cancelationToken)
             return;
 
-        request->call();
+        if (MapUpdaterTask* request = PopTask(p_Index))
+        {
+            char const* l_Name = request->GetName();
+
+            {
+                PerfScopedTimer l_PerfTimer(PERF_CATEGORY_MAP_TASK, uint64(reinterpret_cast<uintptr_t>(l_Name)), l_Name);
+                request->call();
+            }
+
+            request->Release();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_lock);
 
-        delete request;
+        while (!_cancelationToken && _queuedTasks <= 0 && l_Queue.PinnedCount <= 0)
+            _workCondition.wait(lock);
     }
 }
@@ -12,7 +12,7 @@
 #include "Define.h"
 #include "Common.h"
 #include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include <deque>
 
 class MapUpdater;
 
@@ -21,31 +21,46 @@ class MapUpdaterTask
     public:
         /// Constructor
         MapUpdaterTask(MapUpdater* p_Updater);
+        virtual ~MapUpdaterTask() { }
 
         virtual void call() = 0;
 
+        /// Estimated cost of the task in microseconds, heaviest tasks are dispatched first
+        virtual uint32 GetCost() const { return 0; }
+        /// Map id used to pin the task on a specific worker, 0 if the task can run anywhere
+        virtual uint32 GetPinnedMapId() const { return 0; }
+
+        /// Name used by the tick profiler, must be a string literal
+        virtual char const* GetName() const { return "MapUpdaterTask"; }
+
+        /// Give the task back once executed (tasks owned by a pool override this)
+        virtual void Release() { delete this; }
+
         /// Notify that the task is done
         void UpdateFinished();
 
-    private:
+    protected:
         MapUpdater* m_updater;
 
 };
 
 class Map;
+class MapUpdateRequest;
 
 class MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
-        ~MapUpdater() { };
+        MapUpdater() : _cancelationToken(false), _pendingRequests(0), _queuedTasks(0), _threadAffinity(false) {}
+        ~MapUpdater();
 
         friend class MapUpdaterTask;
+        friend class MapUpdateRequest;
 
         void schedule_update(Map& map, uint32 diff);
         void schedule_specific(MapUpdaterTask* p_Request);
 
+        /// Dispatch the scheduled batch (heaviest first) and wait for every task to be done
         void wait();
 
         void activate(size_t num_threads);
@@ -54,20 +69,55 @@ class MapUpdater
 
         bool activated();
 
+        /// Bind every worker thread to its own core
+        void SetThreadAffinity(bool p_Enabled) { _threadAffinity = p_Enabled; }
+        /// Always run the given map (and its instances) on the same worker, it will never be stolen
+        void PinMap(uint32 p_MapId);
+
     private:
 
-        ProducerConsumerQueue<MapUpdaterTask*> _queue;
+        /// Per worker task storage, idle workers steal from the others
+        struct WorkerQueue
+        {
+            WorkerQueue() : PinnedCount(0) { }
+
+            std::mutex Lock;
+            std::deque<MapUpdaterTask*> Tasks;      ///< Sorted by cost, heaviest at the back
+            std::deque<MapUpdaterTask*> Pinned;     ///< Never stolen
+            std::atomic<int32> PinnedCount;
+        };
+
+        void Dispatch(MapUpdaterTask* p_Task, size_t p_Worker);
+        void DispatchBatch();
+        MapUpdaterTask* PopTask(size_t p_Worker);
+        MapUpdaterTask* StealTask(size_t p_Thief);
+
+        MapUpdateRequest* AcquireRequest(Map& p_Map, uint32 p_Diff);
+        void ReleaseRequest(MapUpdateRequest* p_Request);
+
+        void update_finished();
+
+        void WorkerThread(size_t p_Index);
 
         std::vector<std::thread> _workerThreads;
+        std::vector<WorkerQueue*> _workerQueues;
         std::atomic<bool> _cancelationToken;
 
+        /// Tasks scheduled from outside the pool, dispatched heaviest first on wait()
+        std::vector<MapUpdaterTask*> _batch;
+        std::mutex _batchLock;
+
         std::mutex _lock;
-        std::condition_variable _condition;
-        size_t pending_requests;
+        std::condition_variable _condition;         ///< Signaled when every pending request is done
+        std::condition_variable _workCondition;     ///< Signaled when new tasks are dispatched
+        std::atomic<size_t> _pendingRequests;
+        std::atomic<int32> _queuedTasks;
 
-        void update_finished();
+        std::mutex _poolLock;
+        std::vector<MapUpdateRequest*> _requestPool;
 
-        void WorkerThread();
+        std::unordered_map<uint32, size_t> _pinnedMaps;
+        bool _threadAffinity;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
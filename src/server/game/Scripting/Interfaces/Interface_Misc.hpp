@@ -46,10 +46,10 @@ class ServerScript : public ScriptObjectImpl<false>
             UNUSED(p_WasNew);
         }
 
-        /// Called when a packet is sent to a client. The packet object is a copy of the original packet, so reading and modifying it is safe.
+        /// Called when a packet is sent to a client. The packet can be shared by several sockets, it must only be read.
         /// @p_Socket : Socket who send the packet
         /// @p_Packet : Sent packet
-        virtual void OnPacketSend(WorldSocket * p_Socket, WorldPacket & p_Packet)
+        virtual void OnPacketSend(WorldSocket * p_Socket, WorldPacket const& p_Packet)
         {
             UNUSED(p_Socket);
             UNUSED(p_Packet);
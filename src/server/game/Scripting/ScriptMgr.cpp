@@ -1414,10 +1414,10 @@ void ScriptMgr::OnPacketReceive(WorldSocket* p_Socket, WorldPacket p_Packet, Wor
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(p_Socket, p_Packet, p_Session);
 }
 
-/// Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so reading and modifying it is safe.
-/// @p_Socket : Socket who received the packet
-/// @p_Packet : Received packet
-void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket p_Packet)
+/// Called when a packet is sent to a client. The packet can be shared by several sockets, it must only be read.
+/// @p_Socket : Socket who send the packet
+/// @p_Packet : Sent packet
+void ScriptMgr::OnPacketSend(WorldSocket* p_Socket, WorldPacket const& p_Packet)
 {
     ASSERT(p_Socket);
 
@@ -1990,7 +1990,8 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,                                        // process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                       // packet is not thread-safe - process it in World::UpdateSessions()
-    PROCESS_THREADSAFE                                          // packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE,                                         // packet is thread-safe - process it in Map::Update()
+    PROCESS_SESSION_PARALLEL                                    // packet only reads shared data and writes to its own session - process it on the map update threads before World::UpdateSessions()
 };
 
 enum IRPacketProcessing
@@ -100,8 +100,13 @@ void WorldPacket::Compress(void* dst, uint32 *dst_size, const void* src, int src
     *dst_size -= _compressionStream->avail_out;
 }
 
-void WorldPacket::OnSend()
+void WorldPacket::OnSend() const
 {
+    if (m_Profiled)
+        return;
+
+    m_Profiled = true;
+
     if (m_opcode != UNKNOWN_OPCODE && _storage.size() > m_BaseSize)
     {
         gPacketProfilerMutex.lock();
@@ -109,3 +114,14 @@ void WorldPacket::OnSend()
         gPacketProfilerMutex.unlock();
     }
 }
+
+SharedWorldPacket WorldPacket::Share() const
+{
+    /// Profiled here rather than by each session, the copy keeps the flag
+    OnSend();
+
+    WorldPacket* l_Copy = new WorldPacket(*this);
+    l_Copy->FlushBits();
+
+    return SharedWorldPacket(l_Copy);
+}
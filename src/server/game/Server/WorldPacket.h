@@ -14,6 +14,10 @@
 #include "ByteBuffer.h"
 
 struct z_stream_s;
+class WorldPacket;
+
+/// Server packet built once and sent to several sessions, each socket only encrypts its own header
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
 
 extern std::mutex gPacketProfilerMutex;
 extern std::map<uint32, uint32> gPacketProfilerData;
@@ -22,15 +26,15 @@ class WorldPacket : public ByteBuffer
 {
     public:
                                                             // just container for later use
-        WorldPacket() : ByteBuffer(0), m_opcode((uint16)UNKNOWN_OPCODE)
+        WorldPacket() : ByteBuffer(0), m_opcode((uint16)UNKNOWN_OPCODE), m_Profiled(false)
         {
         }
 
-        WorldPacket(uint16 opcode, size_t res = 200) : ByteBuffer(res), m_opcode(opcode)
+        WorldPacket(uint16 opcode, size_t res = 200) : ByteBuffer(res), m_opcode(opcode), m_Profiled(false)
         {
         }
                                                             // copy constructor
-        WorldPacket(WorldPacket const& packet) : ByteBuffer(packet), m_opcode(packet.m_opcode)
+        WorldPacket(WorldPacket const& packet) : ByteBuffer(packet), m_opcode(packet.m_opcode), m_Profiled(packet.m_Profiled)
         {
         }
 
@@ -40,9 +44,14 @@ class WorldPacket : public ByteBuffer
             _storage.reserve(newres);
             m_opcode = opcode;
             m_BaseSize = newres;
+            m_Profiled = false;
         }
 
-        void OnSend();
+        /// Record the packet size in the packet profiler, once per packet whatever the number of sessions it is sent to
+        void OnSend() const;
+
+        /// Copy the packet once, the copy can then be queued on any number of sockets
+        SharedWorldPacket Share() const;
 
         uint16 GetOpcode() const { return m_opcode; }
         void SetOpcode(uint16 opcode) { m_opcode = opcode; }
@@ -51,6 +60,7 @@ class WorldPacket : public ByteBuffer
 
     protected:
         uint16 m_opcode;
+        mutable bool m_Profiled;
         void Compress(void* dst, uint32 *dst_size, const void* src, int src_size);
         z_stream_s* _compressionStream;
 };
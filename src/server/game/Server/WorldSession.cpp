@@ -45,6 +45,7 @@
 #include "AccountMgr.h"
 #include "PetBattle.h"
 #include "Chat.h"
+#include "PerfProfiler.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -59,7 +60,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //we do not process thread-unsafe packets
-    if (opHandle->packetProcessing == PROCESS_THREADUNSAFE)
+    if (opHandle->packetProcessing == PROCESS_THREADUNSAFE || opHandle->packetProcessing == PROCESS_SESSION_PARALLEL)
         return false;
 
     Player* player = m_pSession->GetPlayer();
@@ -85,7 +86,8 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
-    if (opHandle->packetProcessing == PROCESS_THREADUNSAFE)
+    //session-parallel packets left behind a thread-unsafe one are processed here too, in order
+    if (opHandle->packetProcessing == PROCESS_THREADUNSAFE || opHandle->packetProcessing == PROCESS_SESSION_PARALLEL)
         return true;
 
     //no player attached? -> our client! ^^
@@ -97,6 +99,22 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return (player->IsInWorld() == false);
 }
 
+bool ParallelSessionFilter::Process(WorldPacket* packet)
+{
+    uint16 opcode = DropHighBytes(packet->GetOpcode());
+    OpcodeHandler const* opHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][opcode];
+
+    if (!opHandle || opHandle->packetProcessing != PROCESS_SESSION_PARALLEL)
+        return false;
+
+    if (opHandle->status != STATUS_LOGGEDIN && opHandle->status != STATUS_AUTHED)
+        return false;
+
+    //everything else (login, transfer, interrealm) is left to World::UpdateSessions()
+    Player* player = m_pSession->GetPlayer();
+    return player && player->IsInWorld();
+}
+
 /// WorldSession constructor
 #ifndef CROSS
 WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, bool ispremium, uint8 premiumType, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter, uint32 p_VoteRemainingTime, uint32 p_ServiceFlags, uint32 p_CustomFlags)
@@ -220,19 +238,6 @@ WorldSession::WorldSession(uint32 id, InterRealmClient* irc, AccountTypes sec, b
     m_TransactionCallbacks             = std::unique_ptr<TransactionCallbacks>(new TransactionCallbacks());
     m_PreparedStatementCallbacks       = std::unique_ptr<PreparedStatementCallbacks>(new PreparedStatementCallbacks());
     m_PreparedStatementCallbacksBuffer = std::unique_ptr<PreparedStatementCallbacks>(new PreparedStatementCallbacks());
-
-    _compressionStream = new z_stream();
-    _compressionStream->zalloc = (alloc_func)NULL;
-    _compressionStream->zfree = (free_func)NULL;
-    _compressionStream->opaque = (voidpf)NULL;
-    _compressionStream->avail_in = 0;
-    _compressionStream->next_in = NULL;
-    int32 z_res = deflateInit(_compressionStream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        sLog->outError(LOG_FILTER_NETWORKIO, "Can't initialize packet compression (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        return;
-    }
 }
 
 /// WorldSession destructor
@@ -264,15 +269,6 @@ WorldSession::~WorldSession()
     WorldPacket* packet = NULL;
     while (_recvQueue.next(packet))
         delete packet;
-
-    int32 z_res = deflateEnd(_compressionStream);
-    if (z_res != Z_OK && z_res != Z_DATA_ERROR) // Z_DATA_ERROR signals that internal state was BUSY
-    {
-        sLog->outError(LOG_FILTER_NETWORKIO, "Can't close packet compression stream (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        return;
-    }
-
-    delete _compressionStream;
 }
 
 /// Get the player name
@@ -316,7 +312,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     if (!ir_packet && GetInterRealmBG() && !CanBeSentDuringInterRealm(packet->GetOpcode()))
         return;
 
-    const_cast<WorldPacket*>(packet)->OnSend();
+    packet->OnSend();
 
     if (packet->GetOpcode() == NULL_OPCODE && !forced)
     {
@@ -361,6 +357,36 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
 #endif
 }
 
+/// Send a packet built once for several sessions, the payload is shared with the other sockets instead of being copied
+void WorldSession::SendSharedPacket(SharedWorldPacket const& p_Packet)
+{
+#ifndef CROSS
+    if (!m_Socket)
+        return;
+
+    if (GetInterRealmBG() && !CanBeSentDuringInterRealm(p_Packet->GetOpcode()))
+        return;
+
+    if (p_Packet->GetOpcode() == NULL_OPCODE || p_Packet->GetOpcode() == UNKNOWN_OPCODE)
+    {
+        sLog->outError(LOG_FILTER_OPCODES, "Prevented sending of NULL_OPCODE/UNKNOWN_OPCODE to %s", GetPlayerName(false).c_str());
+        return;
+    }
+
+    OpcodeHandler* l_Handler = g_OpcodeTable[WOW_SERVER_TO_CLIENT][p_Packet->GetOpcode()];
+    if (!l_Handler || l_Handler->status == STATUS_UNHANDLED)
+    {
+        sLog->outError(LOG_FILTER_OPCODES, "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(p_Packet->GetOpcode(), WOW_SERVER_TO_CLIENT).c_str(), GetPlayerName(false).c_str());
+        return;
+    }
+
+    if (m_Socket->SendPacket(p_Packet) == -1)
+        m_Socket->CloseSocket();
+#else
+    SendPacket(p_Packet.get());
+#endif
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -538,6 +564,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     {
         const OpcodeHandler* opHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][packet->GetOpcode()];
         uint32 pktTime = getMSTime();
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_OPCODE, packet->GetOpcode());
 
         try
         {
@@ -701,6 +728,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             }
         }
 
+        l_PerfTimer.Stop();
         nbPacket++;
 
         if (deletePacket)
@@ -776,6 +804,43 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     return true;
 }
+
+/// Only reads shared data, sessions are never added or removed while the map update threads run this
+void WorldSession::ProcessParallelPackets()
+{
+    if (!m_Socket || m_Socket->IsClosed() || _recvQueue.empty())
+        return;
+
+    ParallelSessionFilter l_Filter(this);
+    WorldPacket* l_Packet = nullptr;
+    uint32 l_ProcessedPackets = 0;
+
+    while (!_recvQueue.empty() && _recvQueue.next(l_Packet, l_Filter))
+    {
+        OpcodeHandler const* l_OpHandle = g_OpcodeTable[WOW_CLIENT_TO_SERVER][l_Packet->GetOpcode()];
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_OPCODE, l_Packet->GetOpcode());
+
+        try
+        {
+            sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*l_Packet), this);
+            (this->*l_OpHandle->handler)(*l_Packet);
+            if (sLog->ShouldLog(LOG_FILTER_NETWORKIO, LOG_LEVEL_TRACE) && l_Packet->rpos() < l_Packet->wpos())
+                LogUnprocessedTail(l_Packet);
+        }
+        catch (ByteBufferException &)
+        {
+            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSession::ProcessParallelPackets ByteBufferException occured while parsing a packet (opcode: %u) from client %s, accountid=%i. Skipped packet.",
+                l_Packet->GetOpcode(), GetRemoteAddress().c_str(), GetAccountId());
+            l_Packet->hexlike();
+        }
+
+        delete l_Packet;
+
+        //same limit than Update(), leftovers are handled next time
+        if (++l_ProcessedPackets > MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE)
+            break;
+    }
+}
 #endif
 
 /// %Log the player out
@@ -1982,8 +2047,9 @@ void WorldSession::LoadCharacter(CharacterPortData const& p_CharacterPortData)
         return;
     }
 
-    m_CharacterLoginCallback = l_RealmDatabase->DelayQueryHolder((SQLQueryHolder*)l_Holer);
-    m_CharacterLoginDBCallback = LoginDatabase.DelayQueryHolder((SQLQueryHolder*)l_LoginDBQueryHolder);
+    /// Same ordering keys as Player::SaveToDB, the login reads must not overtake a pending save
+    m_CharacterLoginCallback = l_RealmDatabase->DelayQueryHolder((SQLQueryHolder*)l_Holer, GUID_LOPART(m_RealGUID));
+    m_CharacterLoginDBCallback = LoginDatabase.DelayQueryHolder((SQLQueryHolder*)l_LoginDBQueryHolder, GetAccountId());
 }
 
 void WorldSession::LoadCharacterDone(LoginQueryHolder* p_CharHolder, LoginDBQueryHolder* p_AuthHolder)
@@ -335,6 +335,18 @@ public:
     virtual bool Process(WorldPacket* packet);
 };
 
+//process only session-parallel packets on the map update threads, stops at the first other packet
+//to keep the order of the queue
+class ParallelSessionFilter : public PacketFilter
+{
+public:
+    explicit ParallelSessionFilter(WorldSession* pSession) : PacketFilter(pSession) {}
+    ~ParallelSessionFilter() {}
+
+    virtual bool Process(WorldPacket* packet);
+    virtual bool ProcessLogout() const { return false; }
+};
+
 // Proxy structure to contain data passed to callback function,
 // only to prevent bloating the parameter list
 class CharacterCreateInfo
@@ -443,6 +455,8 @@ class WorldSession
         static void WriteMovementInfo(WorldPacket& data, MovementInfo* mi);
 
         void SendPacket(WorldPacket const* packet, bool forced = false, bool ir_packet = false);
+        /// Send a packet shared by several sessions (see WorldPacket::Share)
+        void SendSharedPacket(SharedWorldPacket const& p_Packet);
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -493,6 +507,10 @@ class WorldSession
 
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
+#ifndef CROSS
+        /// Handle the PROCESS_SESSION_PARALLEL packets at the head of the queue, called by a map update thread
+        void ProcessParallelPackets();
+#endif
 
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
@@ -633,8 +651,6 @@ class WorldSession
             return true;
         }
 
-        z_stream_s* GetCompressionStream() { return _compressionStream; }
-
         void SetClientBuild(uint16 p_ClientBuild) { m_ClientBuild = p_ClientBuild; }
         uint16 GetClientBuild() const { return m_ClientBuild; }
 
@@ -1657,7 +1673,6 @@ class WorldSession
         uint32 m_uiAntispamMailSentTimer;
 
         uint8 m_PlayerLoginCounter;
-        z_stream_s* _compressionStream;
 
         uint32 m_ServiceFlags;
         uint32 m_CustomFlags;
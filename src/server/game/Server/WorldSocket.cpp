@@ -17,6 +17,8 @@
 #include <ace/OS_NS_string.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
+#include <ace/OS_NS_sys_socket.h>
+#include <ace/os_include/sys/os_uio.h>
 
 #include "WorldSocket.h"
 #include "Common.h"
@@ -41,6 +43,13 @@
 uint32_t gReceivedBytes = 0;
 uint32_t gSentBytes = 0;
 
+/// Packets bigger than that are queued by reference instead of being copied in the output buffer
+#define MAX_COPIED_PACKET_SIZE 1024
+/// Same limit than the former ACE message queue high water mark
+#define MAX_OUT_QUEUE_SIZE (8 * 1024 * 1024)
+/// Iovec entries of a single gather send
+#define MAX_SEND_IOV 64
+
 #if defined(__GNUC__)
 #pragma pack(1)
 #else
@@ -96,14 +105,11 @@ WorldSocket::WorldSocket(void) : WorldHandler(),
 m_LastPingTime(ACE_Time_Value::zero), m_OverSpeedPings(0), m_Session(0),
 m_RecvWPct(0), m_RecvPct(), m_Header(sizeof(AuthClientPktHeader)),
 m_WorldHeader(sizeof(WorldClientPktHeader)), m_OutBuffer(0),
-m_OutBufferSize(65536), m_OutActive(false),
+m_OutBufferSize(65536), m_OutQueueSize(0), m_OutActive(false),
 
 m_Seed(static_cast<uint32> (rand32()))
 {
     reference_counting_policy().value(ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
-
-    msg_queue()->high_water_mark(8 * 1024 * 1024);
-    msg_queue()->low_water_mark(8 * 1024 * 1024);
 }
 
 WorldSocket::~WorldSocket (void)
@@ -148,6 +154,16 @@ const std::string& WorldSocket::GetRemoteAddress (void) const
 }
 
 int WorldSocket::SendPacket(WorldPacket const& pct)
+{
+    return SendPacketImpl(pct, nullptr);
+}
+
+int WorldSocket::SendPacket(SharedWorldPacket const& p_Packet)
+{
+    return SendPacketImpl(*p_Packet, &p_Packet);
+}
+
+int WorldSocket::SendPacketImpl(WorldPacket const& pct, SharedWorldPacket const* p_Shared)
 {
     ACE_GUARD_RETURN (LockType, Guard, m_OutBufferLock, -1);
 
@@ -162,7 +178,10 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
         return 0;
 
     WorldPacket const* pkt = &pct;
-    const_cast<WorldPacket*>(pkt)->FlushBits();
+
+    // Shared packets are flushed by WorldPacket::Share, they can be read by several threads
+    if (!p_Shared)
+        const_cast<WorldPacket*>(pkt)->FlushBits();
 
     gSentBytes += pkt->size() + 3;
 
@@ -187,7 +206,7 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
 
     ServerPktHeader header(!m_Crypt.IsInitialized() ? pkt->size() + 2 : pct.size(), pkt->GetOpcode(), &m_Crypt);
 
-    if (m_OutBuffer->space() >= pkt->size() + header.getHeaderLength() && msg_queue()->is_empty())
+    if (pkt->size() <= MAX_COPIED_PACKET_SIZE && m_OutBuffer->space() >= pkt->size() + header.getHeaderLength() && m_OutQueue.empty())
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy((char*)header.header, header.getHeaderLength()) == -1)
@@ -199,22 +218,21 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     }
     else
     {
-        // Enqueue the packet.
-        ACE_Message_Block* mb;
-
-        ACE_NEW_RETURN(mb, ACE_Message_Block(pkt->size() + header.getHeaderLength()), -1);
-
-        mb->copy((char*)header.header, header.getHeaderLength());
-
-        if (!pkt->empty())
-            mb->copy((const char*)pkt->contents(), pkt->size());
-
-        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        if (m_OutQueueSize + pkt->size() + header.getHeaderLength() > MAX_OUT_QUEUE_SIZE)
         {
-            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendPacket enqueue_tail failed");
-            mb->release();
+            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::SendPacket output queue is full");
             return -1;
         }
+
+        // Enqueue the packet, only the owned packets are copied (once)
+        OutgoingPacket l_Outgoing;
+        l_Outgoing.Packet = p_Shared ? *p_Shared : SharedWorldPacket(new WorldPacket(*pkt));
+        l_Outgoing.HeaderLength = header.getHeaderLength();
+        l_Outgoing.Sent = 0;
+        memcpy(l_Outgoing.Header, header.header, header.getHeaderLength());
+
+        m_OutQueueSize += pkt->size() + header.getHeaderLength();
+        m_OutQueue.push_back(std::move(l_Outgoing));
     }
 
     return 0;
@@ -335,104 +353,111 @@ int WorldSocket::handle_output (ACE_HANDLE)
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
-
-    if (send_len == 0)
-        return handle_output_queue(Guard);
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
+    // Gather the output buffer and the head of the queue in a single send
+    iovec l_Iov[MAX_SEND_IOV];
+    int l_IovCount = 0;
+    size_t send_len = 0;
 
-    if (n == 0)
-        return -1;
-    else if (n == -1)
+    if (m_OutBuffer->length() != 0)
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-            return schedule_wakeup_output (Guard);
-
-        return -1;
+        l_Iov[l_IovCount].iov_base = m_OutBuffer->rd_ptr();
+        l_Iov[l_IovCount].iov_len = m_OutBuffer->length();
+        send_len += m_OutBuffer->length();
+        ++l_IovCount;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
-
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
+    for (std::deque<OutgoingPacket>::iterator l_Itr = m_OutQueue.begin(); l_Itr != m_OutQueue.end() && l_IovCount + 2 <= MAX_SEND_IOV; ++l_Itr)
     {
-        m_OutBuffer->reset();
+        OutgoingPacket& l_Outgoing = *l_Itr;
 
-        return handle_output_queue (Guard);
-    }
-
-    ACE_NOTREACHED (return 0);
-}
-
-int WorldSocket::handle_output_queue (GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
-
-    ACE_Message_Block* mblk;
+        if (l_Outgoing.Sent < l_Outgoing.HeaderLength)
+        {
+            l_Iov[l_IovCount].iov_base = (char*)&l_Outgoing.Header[l_Outgoing.Sent];
+            l_Iov[l_IovCount].iov_len = l_Outgoing.HeaderLength - l_Outgoing.Sent;
+            send_len += l_Iov[l_IovCount].iov_len;
+            ++l_IovCount;
+        }
 
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::handle_output_queue dequeue_head");
-        return -1;
+        size_t l_PayloadSent = l_Outgoing.Sent > l_Outgoing.HeaderLength ? l_Outgoing.Sent - l_Outgoing.HeaderLength : 0;
+        if (l_Outgoing.Packet->size() > l_PayloadSent)
+        {
+            l_Iov[l_IovCount].iov_base = (char*)l_Outgoing.Packet->contents() + l_PayloadSent;
+            l_Iov[l_IovCount].iov_len = l_Outgoing.Packet->size() - l_PayloadSent;
+            send_len += l_Iov[l_IovCount].iov_len;
+            ++l_IovCount;
+        }
     }
 
-    const size_t send_len = mblk->length();
+    if (send_len == 0)
+        return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr l_Message;
+    memset(&l_Message, 0, sizeof(l_Message));
+    l_Message.msg_iov = l_Iov;
+    l_Message.msg_iovlen = l_IovCount;
+
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &l_Message, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len);
+    ssize_t n = peer().sendv (l_Iov, l_IovCount);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
+        return -1;
+    else if (n == -1)
     {
-        mblk->release();
+        if (errno == EWOULDBLOCK || errno == EAGAIN)
+            return schedule_wakeup_output (Guard);
 
         return -1;
     }
-    else if (n == -1)
+
+    // Consume what was written, output buffer first
+    size_t l_Written = static_cast<size_t> (n);
+
+    if (m_OutBuffer->length() != 0)
     {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        if (l_Written >= m_OutBuffer->length())
         {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
+            l_Written -= m_OutBuffer->length();
+            m_OutBuffer->reset();
         }
+        else
+        {
+            m_OutBuffer->rd_ptr (l_Written);
+            l_Written = 0;
 
-        mblk->release();
-        return -1;
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
+        }
     }
-    else if (n < (ssize_t)send_len) //now n > 0
+
+    while (l_Written != 0 && !m_OutQueue.empty())
     {
-        mblk->rd_ptr(static_cast<size_t> (n));
+        OutgoingPacket& l_Outgoing = m_OutQueue.front();
+        size_t l_Left = l_Outgoing.HeaderLength + l_Outgoing.Packet->size() - l_Outgoing.Sent;
 
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+        if (l_Written < l_Left)
         {
-            sLog->outError(LOG_FILTER_NETWORKIO, "WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            l_Outgoing.Sent += l_Written;
+            m_OutQueueSize -= l_Written;
+            l_Written = 0;
+            break;
         }
 
-        return schedule_wakeup_output (g);
+        l_Written -= l_Left;
+        m_OutQueueSize -= l_Left;
+        m_OutQueue.pop_front();
     }
-    else //now n == send_len
-    {
-        mblk->release();
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
-    }
+    if (n < (ssize_t)send_len)
+        return schedule_wakeup_output (Guard);
 
-    ACE_NOTREACHED(return -1);
+    // Everything gathered was sent, packets left behind the iovec limit are sent by the next call
+    if (m_OutQueue.empty())
+        return cancel_wakeup_output(Guard);
+
+    return ACE_Event_Handler::WRITE_MASK;
 }
 
 int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
@@ -468,7 +493,7 @@ int WorldSocket::Update (void)
 
     {
         ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, 0);
-        if (m_OutBuffer->length() == 0 && msg_queue()->is_empty())
+        if (m_OutBuffer->length() == 0 && m_OutQueue.empty())
             return 0;
     }
 
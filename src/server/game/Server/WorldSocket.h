@@ -25,6 +25,7 @@
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
 #include <atomic>
+#include <deque>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -32,9 +33,9 @@
 
 #include "Common.h"
 #include "AuthCrypt.h"
+#include "WorldPacket.h"
 
 class ACE_Message_Block;
-class WorldPacket;
 class WorldSession;
 
 /// Handler that can communicate over stream sockets.
@@ -50,7 +51,10 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  *
  * For output the class uses one buffer (64K usually) and
  * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
+ * the buffer. Queued packets are not copied again: they keep
+ * a reference on the (possibly shared) packet payload and only
+ * their encrypted header is stored, the queue is written with
+ * one gather send. The reason this is done, is because the server
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
@@ -102,6 +106,11 @@ class WorldSocket : public WorldHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a packet shared with other sockets, the payload is never copied
+        /// unless it is small enough to be packed in the output buffer.
+        /// @return -1 of failure
+        int SendPacket(SharedWorldPacket const& p_Packet);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -140,8 +149,8 @@ class WorldSocket : public WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue (GuardType& g);
+        /// Queue or buffer the packet, p_Shared is the shared copy of p_Packet if any
+        int SendPacketImpl(WorldPacket const& p_Packet, SharedWorldPacket const* p_Shared);
 
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
@@ -198,6 +207,21 @@ class WorldSocket : public WorldHandler
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Packet waiting for m_OutBuffer to be sent, only the header is stored
+        struct OutgoingPacket
+        {
+            SharedWorldPacket Packet;
+            uint8 Header[4];
+            uint8 HeaderLength;
+            size_t Sent;                    ///< Bytes of header + payload already sent
+        };
+
+        /// Packets which did not fit in m_OutBuffer, in sending order.
+        std::deque<OutgoingPacket> m_OutQueue;
+
+        /// Bytes waiting in m_OutQueue, the socket is closed past 8MB.
+        size_t m_OutQueueSize;
+
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
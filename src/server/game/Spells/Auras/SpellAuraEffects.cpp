@@ -623,6 +623,13 @@ void AuraEffect::GetApplicationList(std::list<AuraApplication*> & applicationLis
     }
 }
 
+void AuraEffect::InvalidateTargetsModifierCache() const
+{
+    Aura::ApplicationMap const & targetMap = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator appIter = targetMap.begin(); appIter != targetMap.end(); ++appIter)
+        appIter->second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 int32 AuraEffect::CalculateAmount(Unit* caster)
 {
     int32 amount;
@@ -1437,7 +1444,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetsModifierCache();
+        }
         else
             SetAmount(newAmount);
     }
@@ -2032,6 +2042,9 @@ void AuraEffect::HandleShapeshiftBoosts(Unit* target, bool apply) const
         {
             Player* plrTarget = target->ToPlayer();
 
+            /// Casting may learn spells and rehash the spell map, cast once the iteration is over
+            std::vector<uint32> l_SpellsToCast;
+
             PlayerSpellMap const& sp_list = plrTarget->GetSpellMap();
             for (PlayerSpellMap::const_iterator itr = sp_list.begin(); itr != sp_list.end(); ++itr)
             {
@@ -2046,9 +2059,12 @@ void AuraEffect::HandleShapeshiftBoosts(Unit* target, bool apply) const
                     continue;
 
                 if (spellInfo->Stances & (UI64LIT(1) << (GetMiscValue() - 1)))
-                    target->CastSpell(target, itr->first, true, NULL, this);
+                    l_SpellsToCast.push_back(itr->first);
             }
 
+            for (uint32 l_SpellId : l_SpellsToCast)
+                target->CastSpell(target, l_SpellId, true, NULL, this);
+
             // Also do it for Glyphs
             for (uint32 i = 0; i < MAX_GLYPH_SLOT_INDEX; ++i)
             {
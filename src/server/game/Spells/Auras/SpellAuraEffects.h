@@ -35,6 +35,8 @@ class AuraEffect
         Aura* GetBase() const { return (Aura*)m_base; }
         void GetTargetList(std::list<Unit*> & targetList) const;
         void GetApplicationList(std::list<AuraApplication*> & applicationList) const;
+        /// The targets cache the sums of their aura effects, see Unit::InvalidateAuraModifierCache
+        void InvalidateTargetsModifierCache() const;
         SpellModifier* GetSpellModifier() const { return m_spellmod; }
 
         SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
@@ -55,6 +57,7 @@ class AuraEffect
             if (m_amount != amount)
             {
                 m_amount = amount;
+                InvalidateTargetsModifierCache();
                 GetBase()->SetNeedClientUpdateForTargets();
             }
             m_canBeRecalculated = false;
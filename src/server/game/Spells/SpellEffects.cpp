@@ -8261,7 +8261,7 @@ void Spell::EffectThreatAll(SpellEffIndex p_EffIndex)
     if (effectHandleMode != SPELL_EFFECT_HANDLE_LAUNCH)
         return;
 
-    std::list<HostileReference*> l_ThreadList = m_caster->getThreatManager().getThreatList();
+    ThreatContainer::StorageType l_ThreadList = m_caster->getThreatManager().getThreatList();
     for (HostileReference* l_Itr : l_ThreadList)
     {
         Unit* l_Target = l_Itr->getTarget();
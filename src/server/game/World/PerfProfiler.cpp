@@ -0,0 +1,426 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "PerfProfiler.h"
+#include "Config.h"
+#include "Log.h"
+#include "Opcodes.h"
+#include "Timer.h"
+
+static char const* const s_PerfSubsystemNames[PERF_SUBSYSTEM_MAX] =
+{
+    "World",
+    "Sessions",
+    "Maps",
+    "Battlegrounds",
+    "OutdoorPvP",
+    "Battlefields",
+    "LFG",
+    "Callbacks",
+    "Auctions"
+};
+
+static char const* const s_PerfCategoryNames[PERF_CATEGORY_MAX] =
+{
+    "subsystem",
+    "map",
+    "task",
+    "opcode"
+};
+
+PerfHistogram::PerfHistogram()
+{
+    Reset();
+}
+
+uint32 PerfHistogram::GetBucketIndex(uint32 p_Value)
+{
+    if (p_Value < SUB_BUCKET_COUNT)
+        return p_Value;
+
+    uint32 l_HighBit = 31;
+    while (!(p_Value & (1u << l_HighBit)))
+        --l_HighBit;
+
+    uint32 l_Shift = l_HighBit - SUB_BUCKET_BITS;
+    return SUB_BUCKET_COUNT + l_Shift * SUB_BUCKET_COUNT + ((p_Value >> l_Shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+uint32 PerfHistogram::GetBucketUpperBound(uint32 p_Index)
+{
+    if (p_Index < SUB_BUCKET_COUNT)
+        return p_Index;
+
+    uint32 l_Shift = (p_Index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    uint64 l_Lower = uint64(SUB_BUCKET_COUNT + (p_Index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT) << l_Shift;
+    return uint32(std::min<uint64>(l_Lower + (uint64(1) << l_Shift) - 1, 0xFFFFFFFF));
+}
+
+void PerfHistogram::Record(uint32 p_Value)
+{
+    m_Buckets[GetBucketIndex(p_Value)].fetch_add(1, std::memory_order_relaxed);
+    m_Count.fetch_add(1, std::memory_order_relaxed);
+    m_Sum.fetch_add(p_Value, std::memory_order_relaxed);
+
+    uint32 l_Max = m_Max.load(std::memory_order_relaxed);
+    while (p_Value > l_Max && !m_Max.compare_exchange_weak(l_Max, p_Value, std::memory_order_relaxed))
+        ;
+}
+
+void PerfHistogram::Reset()
+{
+    for (uint32 l_I = 0; l_I < BUCKET_COUNT; ++l_I)
+        m_Buckets[l_I].store(0, std::memory_order_relaxed);
+
+    m_Count.store(0, std::memory_order_relaxed);
+    m_Sum.store(0, std::memory_order_relaxed);
+    m_Max.store(0, std::memory_order_relaxed);
+}
+
+PerfHistogram::Snapshot PerfHistogram::GetSnapshot() const
+{
+    Snapshot l_Snapshot;
+    l_Snapshot.Count = 0;
+    l_Snapshot.Sum   = m_Sum.load(std::memory_order_relaxed);
+    l_Snapshot.Max   = m_Max.load(std::memory_order_relaxed);
+    l_Snapshot.P50   = 0;
+    l_Snapshot.P90   = 0;
+    l_Snapshot.P99   = 0;
+    l_Snapshot.P999  = 0;
+
+    /// Buckets are read once so percentiles stay consistent even if samples keep coming
+    uint32 l_Buckets[BUCKET_COUNT];
+    for (uint32 l_I = 0; l_I < BUCKET_COUNT; ++l_I)
+    {
+        l_Buckets[l_I] = m_Buckets[l_I].load(std::memory_order_relaxed);
+        l_Snapshot.Count += l_Buckets[l_I];
+    }
+
+    if (!l_Snapshot.Count)
+        return l_Snapshot;
+
+    struct Percentile
+    {
+        double Ratio;
+        uint32* Value;
+    };
+
+    Percentile l_Percentiles[] =
+    {
+        { 0.50,  &l_Snapshot.P50  },
+        { 0.90,  &l_Snapshot.P90  },
+        { 0.99,  &l_Snapshot.P99  },
+        { 0.999, &l_Snapshot.P999 }
+    };
+
+    uint64 l_Seen = 0;
+    uint32 l_Current = 0;
+    for (uint32 l_I = 0; l_I < BUCKET_COUNT && l_Current < 4; ++l_I)
+    {
+        l_Seen += l_Buckets[l_I];
+
+        while (l_Current < 4 && double(l_Seen) >= l_Percentiles[l_Current].Ratio * double(l_Snapshot.Count))
+        {
+            *l_Percentiles[l_Current].Value = std::min(GetBucketUpperBound(l_I), l_Snapshot.Max);
+            ++l_Current;
+        }
+    }
+
+    return l_Snapshot;
+}
+
+PerfProfiler::PerfProfiler() : m_Enabled(false), m_Opcodes(NUM_OPCODE_HANDLERS), m_LogInterval(0), m_LogTimer(0)
+{
+    for (std::atomic<PerfHistogram*>& l_Opcode : m_Opcodes)
+        l_Opcode.store(nullptr);
+
+    for (uint32 l_Category = 0; l_Category < PERF_CATEGORY_MAX; ++l_Category)
+    {
+        for (uint32 l_I = 0; l_I < KEYED_SLOT_COUNT; ++l_I)
+            m_Keyed[l_Category][l_I].store(nullptr);
+    }
+}
+
+PerfProfiler::~PerfProfiler()
+{
+    for (std::atomic<PerfHistogram*>& l_Opcode : m_Opcodes)
+        delete l_Opcode.load();
+
+    for (uint32 l_Category = 0; l_Category < PERF_CATEGORY_MAX; ++l_Category)
+    {
+        for (uint32 l_I = 0; l_I < KEYED_SLOT_COUNT; ++l_I)
+            delete m_Keyed[l_Category][l_I].load();
+    }
+
+    for (auto const& l_Retired : m_Retired)
+        delete l_Retired.second;
+}
+
+void PerfProfiler::LoadConfig()
+{
+    m_Enabled     = ConfigMgr::GetBoolDefault("Perf.Enable", false);
+    m_LogFile     = ConfigMgr::GetStringDefault("Perf.LogFile", "");
+    m_LogInterval = ConfigMgr::GetIntDefault("Perf.LogInterval", 60) * IN_MILLISECONDS;
+    m_LogTimer    = 0;
+}
+
+void PerfProfiler::Record(PerfCategory p_Category, uint64 p_Key, uint32 p_Microseconds, char const* p_Name)
+{
+    switch (p_Category)
+    {
+        case PERF_CATEGORY_SUBSYSTEM:
+            if (p_Key < PERF_SUBSYSTEM_MAX)
+                m_Subsystems[p_Key].Record(p_Microseconds);
+            break;
+        case PERF_CATEGORY_OPCODE:
+        {
+            if (p_Key >= m_Opcodes.size())
+                break;
+
+            PerfHistogram* l_Histogram = m_Opcodes[p_Key].load(std::memory_order_acquire);
+            if (!l_Histogram)
+            {
+                PerfHistogram* l_New = new PerfHistogram();
+                if (m_Opcodes[p_Key].compare_exchange_strong(l_Histogram, l_New, std::memory_order_acq_rel))
+                    l_Histogram = l_New;
+                else
+                    delete l_New;
+            }
+
+            l_Histogram->Record(p_Microseconds);
+            break;
+        }
+        case PERF_CATEGORY_MAP:
+        case PERF_CATEGORY_MAP_TASK:
+        {
+            if (KeyedHistogram* l_Histogram = FindOrCreateKeyed(p_Category, p_Key, p_Name))
+                l_Histogram->Record(p_Microseconds);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+PerfProfiler::KeyedHistogram* PerfProfiler::FindOrCreateKeyed(PerfCategory p_Category, uint64 p_Key, char const* p_Name)
+{
+    std::atomic<KeyedHistogram*>* l_Slots = m_Keyed[p_Category];
+    uint32 l_Start = uint32((p_Key * UI64LIT(0x9E3779B97F4A7C15)) >> (64 - KEYED_SLOT_BITS));
+
+    KeyedHistogram* l_New = nullptr;
+    for (uint32 l_I = 0; l_I < KEYED_SLOT_COUNT; ++l_I)
+    {
+        std::atomic<KeyedHistogram*>& l_Slot = l_Slots[(l_Start + l_I) & (KEYED_SLOT_COUNT - 1)];
+        KeyedHistogram* l_Histogram = l_Slot.load(std::memory_order_acquire);
+
+        if (!l_Histogram)
+        {
+            if (!l_New)
+                l_New = new KeyedHistogram(p_Key, p_Name);
+
+            if (l_Slot.compare_exchange_strong(l_Histogram, l_New, std::memory_order_acq_rel))
+                return l_New;
+
+            /// Another thread took the slot meanwhile, l_Histogram now holds its histogram
+        }
+
+        if (l_Histogram->Key == p_Key)
+        {
+            delete l_New;
+            return l_Histogram;
+        }
+    }
+
+    delete l_New;
+    return nullptr;
+}
+
+void PerfProfiler::Update(uint32 p_Diff)
+{
+    if (!IsEnabled() || m_LogFile.empty() || !m_LogInterval)
+        return;
+
+    m_LogTimer += p_Diff;
+    if (m_LogTimer < m_LogInterval)
+        return;
+
+    m_LogTimer = 0;
+
+    WriteLogFile();
+    Reset();
+}
+
+std::string PerfProfiler::GetEntryName(PerfCategory p_Category, uint64 p_Key) const
+{
+    switch (p_Category)
+    {
+        case PERF_CATEGORY_SUBSYSTEM:
+            return p_Key < PERF_SUBSYSTEM_MAX ? s_PerfSubsystemNames[p_Key] : "Unknown";
+        case PERF_CATEGORY_MAP:
+        {
+            std::ostringstream l_Name;
+            l_Name << uint32(p_Key >> 32) << ':' << uint32(p_Key & 0xFFFFFFFF);
+            return l_Name.str();
+        }
+        case PERF_CATEGORY_MAP_TASK:
+            return "MapUpdaterTask";
+        case PERF_CATEGORY_OPCODE:
+        {
+            OpcodeHandler const* l_Handler = g_OpcodeTable[WOW_CLIENT_TO_SERVER][p_Key & 0x7FFF];
+            if (l_Handler)
+                return l_Handler->name;
+
+            std::ostringstream l_Name;
+            l_Name << "0x" << std::hex << std::uppercase << p_Key;
+            return l_Name.str();
+        }
+        default:
+            return "Unknown";
+    }
+}
+
+std::vector<PerfProfiler::Entry> PerfProfiler::GetEntries(PerfCategory p_Category) const
+{
+    std::vector<Entry> l_Entries;
+
+    auto l_AddEntry = [this, &l_Entries, p_Category](uint64 p_Key, PerfHistogram const& p_Histogram, char const* p_Name) -> void
+    {
+        /// The snapshot is taken once, a Reset running meanwhile can't leave an entry without samples
+        Entry l_Entry;
+        l_Entry.Stats = p_Histogram.GetSnapshot();
+        if (!l_Entry.Stats.Count)
+            return;
+
+        l_Entry.Name = p_Name ? p_Name : GetEntryName(p_Category, p_Key);
+        l_Entries.push_back(l_Entry);
+    };
+
+    switch (p_Category)
+    {
+        case PERF_CATEGORY_SUBSYSTEM:
+            for (uint32 l_I = 0; l_I < PERF_SUBSYSTEM_MAX; ++l_I)
+                l_AddEntry(l_I, m_Subsystems[l_I], nullptr);
+            break;
+        case PERF_CATEGORY_OPCODE:
+            for (size_t l_I = 0; l_I < m_Opcodes.size(); ++l_I)
+            {
+                if (PerfHistogram const* l_Histogram = m_Opcodes[l_I].load(std::memory_order_acquire))
+                    l_AddEntry(l_I, *l_Histogram, nullptr);
+            }
+            break;
+        case PERF_CATEGORY_MAP:
+        case PERF_CATEGORY_MAP_TASK:
+        {
+            /// Histograms dropped by Reset are only deleted by a later Reset
+            std::lock_guard<std::mutex> l_Guard(m_ReportLock);
+            for (uint32 l_I = 0; l_I < KEYED_SLOT_COUNT; ++l_I)
+            {
+                if (KeyedHistogram const* l_Histogram = m_Keyed[p_Category][l_I].load(std::memory_order_acquire))
+                    l_AddEntry(l_Histogram->Key, *l_Histogram, l_Histogram->Name);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    std::sort(l_Entries.begin(), l_Entries.end(), [](Entry const& p_A, Entry const& p_B) -> bool
+    {
+        return p_A.Stats.P99 > p_B.Stats.P99;
+    });
+
+    return l_Entries;
+}
+
+void PerfProfiler::Reset()
+{
+    for (uint32 l_I = 0; l_I < PERF_SUBSYSTEM_MAX; ++l_I)
+        m_Subsystems[l_I].Reset();
+
+    for (std::atomic<PerfHistogram*>& l_Opcode : m_Opcodes)
+    {
+        if (PerfHistogram* l_Histogram = l_Opcode.load(std::memory_order_acquire))
+            l_Histogram->Reset();
+    }
+
+    std::lock_guard<std::mutex> l_Guard(m_ReportLock);
+
+    uint32 l_Now = getMSTime();
+
+    /// A recording that found one of these histograms before it was dropped is long finished
+    for (std::vector<std::pair<uint32, KeyedHistogram*>>::iterator l_Itr = m_Retired.begin(); l_Itr != m_Retired.end();)
+    {
+        if (getMSTimeDiff(l_Itr->first, l_Now) < RETIRED_DELETE_TIME)
+        {
+            ++l_Itr;
+            continue;
+        }
+
+        delete l_Itr->second;
+        l_Itr = m_Retired.erase(l_Itr);
+    }
+
+    for (uint32 l_Category = 0; l_Category < PERF_CATEGORY_MAX; ++l_Category)
+    {
+        for (uint32 l_I = 0; l_I < KEYED_SLOT_COUNT; ++l_I)
+        {
+            std::atomic<KeyedHistogram*>& l_Slot = m_Keyed[l_Category][l_I];
+
+            KeyedHistogram* l_Histogram = l_Slot.load(std::memory_order_acquire);
+            if (!l_Histogram)
+                continue;
+
+            /// Idle for a whole window (unloaded map, finished instance...)
+            /// A key further on the probe sequence can then be inserted again in the freed slot, its previous histogram isn't found anymore and is dropped by the next Reset
+            if (!l_Histogram->GetCount())
+            {
+                l_Slot.store(nullptr, std::memory_order_release);
+                m_Retired.push_back(std::make_pair(l_Now, l_Histogram));
+                continue;
+            }
+
+            l_Histogram->Reset();
+        }
+    }
+}
+
+char const* PerfProfiler::GetCategoryName(PerfCategory p_Category)
+{
+    return p_Category < PERF_CATEGORY_MAX ? s_PerfCategoryNames[p_Category] : "unknown";
+}
+
+void PerfProfiler::WriteLogFile()
+{
+    FILE* l_File = fopen(m_LogFile.c_str(), "a");
+    if (!l_File)
+    {
+        sLog->outError(LOG_FILTER_GENERAL, "PerfProfiler: can't open %s for writing, file sink disabled", m_LogFile.c_str());
+        m_LogFile.clear();
+        return;
+    }
+
+    uint64 l_Now = uint64(time(nullptr));
+
+    for (uint32 l_Category = 0; l_Category < PERF_CATEGORY_MAX; ++l_Category)
+    {
+        std::vector<Entry> l_Entries = GetEntries(PerfCategory(l_Category));
+        for (Entry const& l_Entry : l_Entries)
+        {
+            uint64 l_Count = l_Entry.Stats.Count;
+            if (!l_Count)
+                continue;
+
+            /// Names are opcode / task / subsystem identifiers, they never need escaping
+            fprintf(l_File, "{\"time\":" UI64FMTD ",\"category\":\"%s\",\"name\":\"%s\",\"count\":" UI64FMTD ",\"avg\":" UI64FMTD ",\"p50\":%u,\"p90\":%u,\"p99\":%u,\"p999\":%u,\"max\":%u}\n",
+                l_Now, GetCategoryName(PerfCategory(l_Category)), l_Entry.Name.c_str(), l_Count, l_Entry.Stats.Sum / l_Count,
+                l_Entry.Stats.P50, l_Entry.Stats.P90, l_Entry.Stats.P99, l_Entry.Stats.P999, l_Entry.Stats.Max);
+        }
+    }
+
+    fclose(l_File);
+}
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PERFPROFILER_H
+# define PERFPROFILER_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+#include <chrono>
+
+enum PerfCategory
+{
+    PERF_CATEGORY_SUBSYSTEM     = 0,        ///< World::Update steps, key is PerfSubsystem
+    PERF_CATEGORY_MAP           = 1,        ///< Map::Update, key is (map id << 32) | instance id
+    PERF_CATEGORY_MAP_TASK      = 2,        ///< MapUpdaterTask::call, key is the task name pointer
+    PERF_CATEGORY_OPCODE        = 3,        ///< Client opcode handlers, key is the opcode
+    PERF_CATEGORY_MAX
+};
+
+enum PerfSubsystem
+{
+    PERF_SUBSYSTEM_WORLD        = 0,
+    PERF_SUBSYSTEM_SESSIONS,
+    PERF_SUBSYSTEM_MAPS,
+    PERF_SUBSYSTEM_BATTLEGROUNDS,
+    PERF_SUBSYSTEM_OUTDOORPVP,
+    PERF_SUBSYSTEM_BATTLEFIELDS,
+    PERF_SUBSYSTEM_LFG,
+    PERF_SUBSYSTEM_CALLBACKS,
+    PERF_SUBSYSTEM_AUCTIONS,
+    PERF_SUBSYSTEM_MAX
+};
+
+/// Log-linear histogram of durations in microseconds, 16 sub buckets per power of two (~6% precision)
+class PerfHistogram
+{
+    public:
+        enum
+        {
+            SUB_BUCKET_BITS  = 4,
+            SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS,
+            BUCKET_COUNT     = SUB_BUCKET_COUNT + (32 - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT
+        };
+
+        struct Snapshot
+        {
+            uint64 Count;
+            uint64 Sum;
+            uint32 Max;
+            uint32 P50;
+            uint32 P90;
+            uint32 P99;
+            uint32 P999;
+        };
+
+        PerfHistogram();
+
+        /// Lock free, can be called from any thread
+        void Record(uint32 p_Value);
+        void Reset();
+
+        uint64 GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+        Snapshot GetSnapshot() const;
+
+    private:
+        static uint32 GetBucketIndex(uint32 p_Value);
+        static uint32 GetBucketUpperBound(uint32 p_Index);
+
+        std::atomic<uint32> m_Buckets[BUCKET_COUNT];
+        std::atomic<uint64> m_Count;
+        std::atomic<uint64> m_Sum;
+        std::atomic<uint32> m_Max;
+};
+
+/// Collects tick timings per subsystem, map, map updater task and opcode
+/// Shown by the .perf command and periodically written as JSON lines to Perf.LogFile
+class PerfProfiler
+{
+    friend class ACE_Singleton<PerfProfiler, ACE_Null_Mutex>;
+
+    public:
+        struct Entry
+        {
+            std::string Name;
+            PerfHistogram::Snapshot Stats;
+        };
+
+        void LoadConfig();
+
+        bool IsEnabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+        void SetEnabled(bool p_Enabled) { m_Enabled = p_Enabled; }
+
+        /// p_Name must outlive the profiler (string literal), it is only used for map updater tasks
+        void Record(PerfCategory p_Category, uint64 p_Key, uint32 p_Microseconds, char const* p_Name = nullptr);
+
+        /// Called by the world thread, writes the window to the log file once per interval
+        void Update(uint32 p_Diff);
+
+        /// Statistics of the current window, sorted by descending p99
+        std::vector<Entry> GetEntries(PerfCategory p_Category) const;
+
+        /// Drop every sample of the current window
+        void Reset();
+
+        static char const* GetCategoryName(PerfCategory p_Category);
+
+    private:
+        PerfProfiler();
+        ~PerfProfiler();
+
+        enum
+        {
+            KEYED_SLOT_BITS     = 12,
+            KEYED_SLOT_COUNT    = 1 << KEYED_SLOT_BITS,     ///< Per category, far more than the maps and tasks alive at once
+            RETIRED_DELETE_TIME = 10 * IN_MILLISECONDS      ///< No recording keeps a histogram that long
+        };
+
+        /// Histogram of a map or a map updater task, it carries its key so a slot reused by another key is never mixed up
+        struct KeyedHistogram : public PerfHistogram
+        {
+            KeyedHistogram(uint64 p_Key, char const* p_Name) : Key(p_Key), Name(p_Name) { }
+
+            uint64 const Key;
+            char const* const Name;
+        };
+
+        /// Lock free, returns nullptr if the table of the category is full
+        KeyedHistogram* FindOrCreateKeyed(PerfCategory p_Category, uint64 p_Key, char const* p_Name);
+
+        std::string GetEntryName(PerfCategory p_Category, uint64 p_Key) const;
+        void WriteLogFile();
+
+        std::atomic<bool> m_Enabled;
+
+        PerfHistogram m_Subsystems[PERF_SUBSYSTEM_MAX];
+        std::vector<std::atomic<PerfHistogram*>> m_Opcodes;     ///< Allocated on first use, never freed before shutdown
+
+        /// Maps and tasks come and go, open addressing tables filled with compare and swap, their histograms are dropped once idle for a whole window
+        std::atomic<KeyedHistogram*> m_Keyed[PERF_CATEGORY_MAX][KEYED_SLOT_COUNT];
+        std::vector<std::pair<uint32, KeyedHistogram*>> m_Retired;  ///< Dropped histograms and their drop time, a recording may still use them
+
+        /// Serializes Reset and the reports, never taken by Record
+        mutable std::mutex m_ReportLock;
+
+        std::string m_LogFile;
+        uint32 m_LogInterval;
+        uint32 m_LogTimer;
+};
+
+#define sPerfProfiler ACE_Singleton<PerfProfiler, ACE_Null_Mutex>::instance()
+
+/// Measure the lifetime of the object, does nothing when the profiler is disabled
+class PerfScopedTimer
+{
+    public:
+        PerfScopedTimer(PerfCategory p_Category, uint64 p_Key, char const* p_Name = nullptr)
+            : m_Category(p_Category), m_Key(p_Key), m_Name(p_Name), m_Running(sPerfProfiler->IsEnabled())
+        {
+            if (m_Running)
+                m_Start = std::chrono::steady_clock::now();
+        }
+
+        ~PerfScopedTimer()
+        {
+            Stop();
+        }
+
+        void Stop()
+        {
+            if (!m_Running)
+                return;
+
+            m_Running = false;
+
+            uint64 l_Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_Start).count();
+            sPerfProfiler->Record(m_Category, m_Key, uint32(std::min<uint64>(l_Elapsed, 0xFFFFFFFF)), m_Name);
+        }
+
+    private:
+        PerfCategory m_Category;
+        uint64 m_Key;
+        char const* m_Name;
+        bool m_Running;
+        std::chrono::steady_clock::time_point m_Start;
+};
+
+#endif // PERFPROFILER_H
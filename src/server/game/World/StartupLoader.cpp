@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "StartupLoader.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "Timer.h"
+
+StartupLoaderGraph::StartupLoaderGraph(char const* p_Name)
+    : m_Name(p_Name), m_Remaining(0)
+{
+}
+
+void StartupLoaderGraph::Add(char const* p_Name, LoaderFunction p_Function, std::initializer_list<char const*> p_Dependencies)
+{
+    uint32 l_Index = uint32(m_Loaders.size());
+
+    Loader l_Loader;
+    l_Loader.Name                = p_Name;
+    l_Loader.Function            = p_Function;
+    l_Loader.PendingDependencies = 0;
+    l_Loader.Duration            = 0;
+    l_Loader.Worker              = 0;
+
+    /// Dependencies must be added first, this keeps the graph acyclic and the insertion order a valid serial order
+    for (char const* l_Dependency : p_Dependencies)
+    {
+        uint32 l_DependencyIndex = 0;
+        while (l_DependencyIndex < l_Index && m_Loaders[l_DependencyIndex].Name != l_Dependency)
+            ++l_DependencyIndex;
+
+        ASSERT(l_DependencyIndex < l_Index && "Startup loader dependency must be added before its dependents");
+
+        l_Loader.Dependencies.push_back(l_DependencyIndex);
+        m_Loaders[l_DependencyIndex].Dependents.push_back(l_Index);
+        ++l_Loader.PendingDependencies;
+    }
+
+    m_Loaders.push_back(l_Loader);
+}
+
+void StartupLoaderGraph::Run(uint32 p_Threads)
+{
+    uint32 l_StartTime = getMSTime();
+
+    p_Threads = std::max<uint32>(1, std::min<uint32>(p_Threads, uint32(m_Loaders.size())));
+
+    if (p_Threads == 1)
+    {
+        for (uint32 l_I = 0; l_I < m_Loaders.size(); ++l_I)
+            Execute(l_I, 0);
+    }
+    else
+    {
+        m_Remaining = uint32(m_Loaders.size());
+
+        for (uint32 l_I = 0; l_I < m_Loaders.size(); ++l_I)
+        {
+            if (!m_Loaders[l_I].PendingDependencies)
+                m_Ready.push_back(l_I);
+        }
+
+        std::vector<std::thread> l_Threads;
+        for (uint32 l_I = 1; l_I < p_Threads; ++l_I)
+            l_Threads.push_back(std::thread(&StartupLoaderGraph::WorkerThread, this, l_I));
+
+        /// The calling thread takes part
+        WorkerThread(0);
+
+        for (std::thread& l_Thread : l_Threads)
+            l_Thread.join();
+    }
+
+    LogReport(GetMSTimeDiffToNow(l_StartTime), p_Threads);
+}
+
+void StartupLoaderGraph::WorkerThread(uint32 p_Worker)
+{
+    if (p_Worker)
+        MySQL::Thread_Init();
+
+    for (;;)
+    {
+        uint32 l_LoaderIndex;
+
+        {
+            std::unique_lock<std::mutex> l_Guard(m_Lock);
+            m_Condition.wait(l_Guard, [this]() { return !m_Ready.empty() || !m_Remaining; });
+
+            if (m_Ready.empty())
+                break;
+
+            l_LoaderIndex = m_Ready.front();
+            m_Ready.pop_front();
+        }
+
+        Execute(l_LoaderIndex, p_Worker);
+
+        {
+            std::lock_guard<std::mutex> l_Guard(m_Lock);
+
+            --m_Remaining;
+            for (uint32 l_Dependent : m_Loaders[l_LoaderIndex].Dependents)
+            {
+                if (!--m_Loaders[l_Dependent].PendingDependencies)
+                    m_Ready.push_back(l_Dependent);
+            }
+        }
+
+        m_Condition.notify_all();
+    }
+
+    if (p_Worker)
+        MySQL::Thread_End();
+}
+
+void StartupLoaderGraph::Execute(uint32 p_Loader, uint32 p_Worker)
+{
+    Loader& l_Loader = m_Loaders[p_Loader];
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading %s...", l_Loader.Name.c_str());
+
+    uint32 l_StartTime = getMSTime();
+    l_Loader.Function();
+
+    l_Loader.Duration = GetMSTimeDiffToNow(l_StartTime);
+    l_Loader.Worker   = p_Worker;
+}
+
+void StartupLoaderGraph::LogReport(uint32 p_WallTime, uint32 p_Threads) const
+{
+    uint32 l_TotalTime    = 0;
+    uint32 l_CriticalPath = 0;
+
+    /// Insertion order is a topological order, dependencies are always finished first
+    std::vector<uint32> l_FinishTimes(m_Loaders.size(), 0);
+    std::vector<uint32> l_Order(m_Loaders.size());
+
+    for (uint32 l_I = 0; l_I < m_Loaders.size(); ++l_I)
+    {
+        uint32 l_ReadyTime = 0;
+        for (uint32 l_Dependency : m_Loaders[l_I].Dependencies)
+            l_ReadyTime = std::max(l_ReadyTime, l_FinishTimes[l_Dependency]);
+
+        l_FinishTimes[l_I] = l_ReadyTime + m_Loaders[l_I].Duration;
+        l_CriticalPath     = std::max(l_CriticalPath, l_FinishTimes[l_I]);
+        l_TotalTime       += m_Loaders[l_I].Duration;
+        l_Order[l_I]       = l_I;
+    }
+
+    std::sort(l_Order.begin(), l_Order.end(), [this](uint32 p_A, uint32 p_B)
+    {
+        return m_Loaders[p_A].Duration > m_Loaders[p_B].Duration;
+    });
+
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Startup loaders (%s): %u loaders in %u ms with %u threads, %u ms of work, critical path %u ms",
+        m_Name.c_str(), uint32(m_Loaders.size()), p_WallTime, p_Threads, l_TotalTime, l_CriticalPath);
+
+    for (uint32 l_Index : l_Order)
+    {
+        Loader const& l_Loader = m_Loaders[l_Index];
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "   %-40s %7u ms (thread %u)", l_Loader.Name.c_str(), l_Loader.Duration, l_Loader.Worker);
+    }
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STARTUPLOADER_H
+# define STARTUPLOADER_H
+
+#include "Common.h"
+#include <condition_variable>
+#include <deque>
+#include <initializer_list>
+
+/// Dependency graph of startup loaders run on a small thread pool
+/// A loader starts once every loader it depends on is done, so their queries are in flight at the same time
+/// Loaders without a dependency between them must not write to the same containers
+class StartupLoaderGraph
+{
+    public:
+        typedef std::function<void()> LoaderFunction;
+
+        StartupLoaderGraph(char const* p_Name);
+
+        /// p_Dependencies are names of loaders already added to the graph
+        void Add(char const* p_Name, LoaderFunction p_Function, std::initializer_list<char const*> p_Dependencies = {});
+
+        /// Run every loader, serially in insertion order when p_Threads <= 1, then log the time spent by each of them
+        void Run(uint32 p_Threads);
+
+    private:
+        struct Loader
+        {
+            std::string Name;
+            LoaderFunction Function;
+            std::vector<uint32> Dependencies;
+            std::vector<uint32> Dependents;
+            uint32 PendingDependencies;
+            uint32 Duration;
+            uint32 Worker;
+        };
+
+        void WorkerThread(uint32 p_Worker);
+        void Execute(uint32 p_Loader, uint32 p_Worker);
+        void LogReport(uint32 p_WallTime, uint32 p_Threads) const;
+
+        std::string m_Name;
+        std::vector<Loader> m_Loaders;
+
+        std::mutex m_Lock;
+        std::condition_variable m_Condition;        ///< Signaled when loaders become ready or everything is done
+        std::deque<uint32> m_Ready;
+        uint32 m_Remaining;
+};
+
+#endif // STARTUPLOADER_H
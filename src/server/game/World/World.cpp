@@ -94,6 +94,8 @@
 #include "MMapFactory.h"
 #include "TaxiPathGraph.h"
 #include "ChatLexicsCutter.h"
+#include "PerfProfiler.h"
+#include "StartupLoader.h"
 #include <ctime>
 
 uint32 gOnlineGameMaster = 0;
@@ -157,6 +159,7 @@ World::World()
     m_serverUpdateCount = 0;
 
     m_isClosed = false;
+    m_CharacterDBBackPressured = false;
 
     m_CleaningFlags = 0;
 
@@ -1272,6 +1275,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_ENABLE_ONLY_SPECIFIC_MAP]  = ConfigMgr::GetBoolDefault("loading.onlyspecificmaps", false);
     m_bool_configs[CONFIG_ENABLE_RESEARCH_SITE_LOAD] = ConfigMgr::GetBoolDefault("loading.researchsite", true);
     m_bool_configs[CONFIG_ENABLE_ITEM_SPEC_LOAD]     = ConfigMgr::GetBoolDefault("loading.itemspecload", true);
+    m_int_configs[CONFIG_LOADING_THREADS]            = ConfigMgr::GetIntDefault("loading.threads", 4);
 
     FillMapsToLoad();
     sLog->outAshran("WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
@@ -1311,6 +1315,9 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_bool_configs[CONFIG_MAP_UPDATE_THREAD_AFFINITY] = ConfigMgr::GetBoolDefault("MapUpdate.ThreadAffinity", false);
+    m_bool_configs[CONFIG_SESSION_PARALLEL_PACKETS] = ConfigMgr::GetBoolDefault("SessionUpdate.ParallelPackets", false);
+    sPerfProfiler->LoadConfig();
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1627,88 +1634,50 @@ void World::SetInitialWorldSettings()
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    uint32 oldMSTime = getMSTime();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
-
-    if (sWorld->getBoolConfig(CONFIG_ENABLE_LOCALES))
-    {
-        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Localization strings...");
-        sObjectMgr->LoadCreatureLocales();
-        sObjectMgr->LoadGameObjectLocales();
-        sObjectMgr->LoadQuestLocales();
-        sObjectMgr->LoadNpcTextLocales();
-        sObjectMgr->LoadPageTextLocales();
-        sObjectMgr->LoadGossipMenuItemsLocales();
-        sObjectMgr->LoadPointOfInterestLocales();
-
-        sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Creature Text Locales...");
-        sCreatureTextMgr->LoadCreatureTextLocales();
-    }
-
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Garrison Plot Building Content...");
-    sObjectMgr->LoadGarrisonPlotBuildingContent();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Npc Recipes Conditions...");
-    sObjectMgr->LoadNpcRecipesConditions();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+    ///- Independent tables are loaded concurrently, a loader only waits for the ones it depends on
+    ///  Loaders without a declared dependency between them must not share any container
+    StartupLoaderGraph l_Loaders("texts, templates and spells");
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonusess();
+    l_Loaders.Add("Creature Texts",                      []() { sCreatureTextMgr->LoadCreatureTexts(); });
 
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading forbidden spells...");
-    sSpellMgr->LoadForbiddenSpells();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Spell Phase Dbc Info...");
-    sObjectMgr->LoadSpellPhaseInfo();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
-
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    if (sWorld->getBoolConfig(CONFIG_ENABLE_LOCALES))
+    {
+        l_Loaders.Add("Creature Locales",                []() { sObjectMgr->LoadCreatureLocales(); });
+        l_Loaders.Add("Game Object Locales",             []() { sObjectMgr->LoadGameObjectLocales(); });
+        l_Loaders.Add("Quest Locales",                   []() { sObjectMgr->LoadQuestLocales(); });
+        l_Loaders.Add("Npc Text Locales",                []() { sObjectMgr->LoadNpcTextLocales(); });
+        l_Loaders.Add("Page Text Locales",               []() { sObjectMgr->LoadPageTextLocales(); });
+        l_Loaders.Add("Gossip Menu Items Locales",       []() { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        l_Loaders.Add("Point Of Interest Locales",       []() { sObjectMgr->LoadPointOfInterestLocales(); });
+        l_Loaders.Add("Creature Text Locales",           []() { sCreatureTextMgr->LoadCreatureTextLocales(); },     { "Creature Texts" });
+    }
+
+    l_Loaders.Add("Page Texts",                          []() { sObjectMgr->LoadPageTexts(); });
+    l_Loaders.Add("Game Object Templates",               []() { sObjectMgr->LoadGameObjectTemplate(); },            { "Page Texts" });
+    l_Loaders.Add("Garrison Plot Building Content",      []() { sObjectMgr->LoadGarrisonPlotBuildingContent(); },   { "Game Object Templates" });
+    l_Loaders.Add("Npc Recipes Conditions",              []() { sObjectMgr->LoadNpcRecipesConditions(); });
+    l_Loaders.Add("Transport templates",                 []() { sTransportMgr->LoadTransportTemplates(); },         { "Game Object Templates" });
+
+    ///- Spell chains are written into the SpellInfo entries, everything reading ranks waits for them
+    l_Loaders.Add("Spell Rank Data",                     []() { sSpellMgr->LoadSpellRanks(); });
+    l_Loaders.Add("Spell Required Data",                 []() { sSpellMgr->LoadSpellRequired(); },                  { "Spell Rank Data" });
+    l_Loaders.Add("Spell Group types",                   []() { sSpellMgr->LoadSpellGroups(); },                    { "Spell Rank Data" });
+    l_Loaders.Add("Spell Learn Skills",                  []() { sSpellMgr->LoadSpellLearnSkills(); },               { "Spell Rank Data" });
+    l_Loaders.Add("Spell Learn Spells",                  []() { sSpellMgr->LoadSpellLearnSpells(); });
+    l_Loaders.Add("Spell Proc Event conditions",         []() { sSpellMgr->LoadSpellProcEvents(); });
+    l_Loaders.Add("Spell Proc conditions and data",      []() { sSpellMgr->LoadSpellProcs(); },                     { "Spell Rank Data" });
+    l_Loaders.Add("Spell Bonus Data",                    []() { sSpellMgr->LoadSpellBonusess(); });
+    l_Loaders.Add("Aggro Spells Definitions",            []() { sSpellMgr->LoadSpellThreats(); });
+    l_Loaders.Add("Spell Group Stack Rules",             []() { sSpellMgr->LoadSpellGroupStackRules(); },           { "Spell Group types" });
+    l_Loaders.Add("forbidden spells",                    []() { sSpellMgr->LoadForbiddenSpells(); });
+    l_Loaders.Add("Spell Phase Dbc Info",                []() { sObjectMgr->LoadSpellPhaseInfo(); });
+    l_Loaders.Add("NPC Texts",                           []() { sObjectMgr->LoadGossipText(); });
+    l_Loaders.Add("Enchant Spells Proc datas",           []() { sSpellMgr->LoadSpellEnchantProcData(); });
+    l_Loaders.Add("Item Random Enchantments Table",      []() { LoadRandomEnchantmentsTable(); });
+
+    l_Loaders.Run(getIntConfig(CONFIG_LOADING_THREADS));
 
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Disables");
     DisableMgr::LoadDisables();                                                             // must be before loading quests and items
@@ -2414,6 +2383,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    PerfScopedTimer l_WorldPerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_WORLD);
+
     m_updateTime = diff;
 
 #ifdef CROSS
@@ -2522,6 +2493,7 @@ void World::Update(uint32 diff)
         }
 
         ///- Handle expired auctions
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_AUCTIONS);
         sAuctionMgr->Update();
     }
 
@@ -2545,7 +2517,10 @@ void World::Update(uint32 diff)
 
     /// <li> Handle session updates when the timer has passed
     RecordTimeDiff(NULL);
-    UpdateSessions(diff);
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_SESSIONS);
+        UpdateSessions(diff);
+    }
 
     SetRecordDiff(RECORD_DIFF_SESSION, getMSTime() - diffTime);
     diffTime = getMSTime();
@@ -2600,7 +2575,10 @@ void World::Update(uint32 diff)
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
     RecordTimeDiff(NULL);
-    sMapMgr->Update(diff);
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_MAPS);
+        sMapMgr->Update(diff);
+    }
 
     SetRecordDiff(RECORD_DIFF_MAP, getMSTime() - diffTime);
     diffTime = getMSTime();
@@ -2615,17 +2593,26 @@ void World::Update(uint32 diff)
         }
     }
 
-    sBattlegroundMgr->Update(diff);
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_BATTLEGROUNDS);
+        sBattlegroundMgr->Update(diff);
+    }
     SetRecordDiff(RECORD_DIFF_BATTLEGROUND, getMSTime() - diffTime);
     diffTime = getMSTime();
     RecordTimeDiff("UpdateBattlegroundMgr");
 
-    sOutdoorPvPMgr->Update(diff);
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_OUTDOORPVP);
+        sOutdoorPvPMgr->Update(diff);
+    }
     SetRecordDiff(RECORD_DIFF_OUTDOORPVP, getMSTime() - diffTime);
     diffTime = getMSTime();
     RecordTimeDiff("UpdateOutdoorPvPMgr");
 
-    sBattlefieldMgr->Update(diff);
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_BATTLEFIELDS);
+        sBattlefieldMgr->Update(diff);
+    }
     SetRecordDiff(RECORD_DIFF_BATTLEFIELD, getMSTime() - diffTime);
     diffTime = getMSTime();
     RecordTimeDiff("BattlefieldMgr");
@@ -2642,7 +2629,10 @@ void World::Update(uint32 diff)
     sPetBattleSystem->Update(diff);
     sWildBattlePetMgr->Update(diff);
 
-    sLFGMgr->Update(diff);
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_LFG);
+        sLFGMgr->Update(diff);
+    }
     SetRecordDiff(RECORD_DIFF_LFG, getMSTime() - diffTime);
     diffTime = getMSTime();
     RecordTimeDiff("UpdateLFGMgr");
@@ -2653,7 +2643,10 @@ void World::Update(uint32 diff)
 
 #endif /* not CROSS */
     // execute callbacks from sql queries that were queued recently
-    ProcessQueryCallbacks();
+    {
+        PerfScopedTimer l_PerfTimer(PERF_CATEGORY_SUBSYSTEM, PERF_SUBSYSTEM_CALLBACKS);
+        ProcessQueryCallbacks();
+    }
 
     SetRecordDiff(RECORD_DIFF_CALLBACK, getMSTime() - diffTime);
     RecordTimeDiff("ProcessQueryCallbacks");
@@ -2676,6 +2669,18 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_EVENTS].Reset();
     }
 
+    ///- Report character database workers that can't keep up, autosaves are delayed meanwhile
+    bool l_BackPressured = CharacterDatabase.IsBackPressured();
+    if (l_BackPressured != m_CharacterDBBackPressured)
+    {
+        m_CharacterDBBackPressured = l_BackPressured;
+
+        if (l_BackPressured)
+            sLog->outError(LOG_FILTER_SQL_DRIVER, "CharacterDatabase is back pressured, deepest worker queue holds %u operations, delaying autosaves", CharacterDatabase.GetMaxQueueDepth());
+        else
+            sLog->outInfo(LOG_FILTER_SQL_DRIVER, "CharacterDatabase worker queues drained, autosaves resumed");
+    }
+
     ///- Ping to keep MySQL connections alive
     if (m_timers[WUPDATE_PINGDB].Passed())
     {
@@ -2751,6 +2756,7 @@ void World::Update(uint32 diff)
     ProcessCliCommands();
 
     sTimeDiffMgr->Update(diff);
+    sPerfProfiler->Update(diff);
 
     sScriptMgr->OnWorldUpdate(diff);
 }
@@ -3432,6 +3438,10 @@ void World::UpdateSessions(uint32 diff)
         AddNewSession(sess->GetAccountId());
     }
 
+    ///- Handle the read only packets waiting at the head of the queues on the map update threads
+    if (getBoolConfig(CONFIG_SESSION_PARALLEL_PACKETS))
+        UpdateSessionsParallelPackets();
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
@@ -3455,6 +3465,63 @@ void World::UpdateSessions(uint32 diff)
 #endif
 }
 
+#ifndef CROSS
+/// Handle the session-parallel packets of a slice of the session snapshot
+class SessionParallelPacketsRequest : public MapUpdaterTask
+{
+    public:
+        SessionParallelPacketsRequest(MapUpdater* p_Updater, std::vector<WorldSession*> const& p_Sessions, uint32 p_Begin, uint32 p_End)
+            : MapUpdaterTask(p_Updater), m_Sessions(p_Sessions), m_Begin(p_Begin), m_End(p_End)
+        {
+        }
+
+        void call() override
+        {
+            for (uint32 l_I = m_Begin; l_I < m_End; ++l_I)
+                m_Sessions[l_I]->ProcessParallelPackets();
+
+            UpdateFinished();
+        }
+
+        uint32 GetCost() const override { return m_End - m_Begin; }
+        char const* GetName() const override { return "SessionParallelPackets"; }
+
+    private:
+        std::vector<WorldSession*> const& m_Sessions;
+        uint32 m_Begin;
+        uint32 m_End;
+};
+
+/// The map update threads are idle at this point and the world thread waits for them,
+/// a session is handled by a single thread so its packets keep their order
+void World::UpdateSessionsParallelPackets()
+{
+    MapUpdater* l_Updater = sMapMgr->GetMapUpdater();
+    if (!l_Updater->activated())
+        return;
+
+    m_ParallelSessions.clear();
+    for (SessionMap::const_iterator l_Itr = m_sessions.begin(); l_Itr != m_sessions.end(); ++l_Itr)
+    {
+        if (l_Itr->second->GetPlayer() && l_Itr->second->GetPlayer()->IsInWorld())
+            m_ParallelSessions.push_back(l_Itr->second);
+    }
+
+    if (m_ParallelSessions.empty())
+        return;
+
+    /// Small slices, idle threads steal the remaining ones
+    uint32 const l_SliceSize = 32;
+    for (uint32 l_Begin = 0; l_Begin < m_ParallelSessions.size(); l_Begin += l_SliceSize)
+    {
+        uint32 l_End = std::min<uint32>(l_Begin + l_SliceSize, m_ParallelSessions.size());
+        l_Updater->schedule_specific(new SessionParallelPacketsRequest(l_Updater, m_ParallelSessions, l_Begin, l_End));
+    }
+
+    l_Updater->wait();
+}
+#endif
+
 // This handles the issued and queued CLI commands
 void World::ProcessCliCommands()
 {
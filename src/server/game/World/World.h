@@ -222,6 +222,8 @@ enum WorldBoolConfigs
     CONFIG_ENABLE_RESEARCH_SITE_LOAD,
     CONFIG_ENABLE_ITEM_SPEC_LOAD,
     CONFIG_MUST_HAVE_AUTHENTICATOR_ACCESS,
+    CONFIG_MAP_UPDATE_THREAD_AFFINITY,
+    CONFIG_SESSION_PARALLEL_PACKETS,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -425,6 +427,7 @@ enum WorldIntConfigs
     CONFIG_ACCOUNT_BIND_SHOP_GROUP_MASK,
     CONFIG_ACCOUNT_BIND_ALLOWED_GROUP_MASK,
     CONFIG_ONLY_MAP,
+    CONFIG_LOADING_THREADS,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -896,6 +899,10 @@ class World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+#ifndef CROSS
+        /// Handle the session-parallel packets of every session on the map update threads
+        void UpdateSessionsParallelPackets();
+#endif
         /// Set a server rate (see #Rates)
         void setRate(Rates rate, float value) { rate_values[rate]=value; }
         /// Get a server rate (see #Rates)
@@ -1069,6 +1076,7 @@ class World
         uint32 m_CleaningFlags;
 
         bool m_isClosed;
+        bool m_CharacterDBBackPressured;                    ///< Last back pressure state of CharacterDatabase, logged on change
 
         time_t m_startTime;
         time_t m_gameTime;
@@ -1095,6 +1103,7 @@ class World
 #ifndef CROSS
         InterRealmSession* m_InterRealmSession;
         SessionMap m_sessions;
+        std::vector<WorldSession*> m_ParallelSessions;      ///< Snapshot of m_sessions handed to the map update threads
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
 
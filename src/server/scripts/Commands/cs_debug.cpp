@@ -2172,8 +2172,8 @@ class debug_commandscript: public CommandScript
             if (!target || target->isTotem() || target->isPet())
                 return false;
 
-            std::list<HostileReference*>& threatList = target->getThreatManager().getThreatList();
-            std::list<HostileReference*>::iterator itr;
+            ThreatContainer::StorageType& threatList = target->getThreatManager().getThreatList();
+            ThreatContainer::StorageType::iterator itr;
             uint32 count = 0;
             handler->PSendSysMessage("Threat list of %s (guid %u)", target->GetName(), target->GetGUIDLow());
             for (itr = threatList.begin(); itr != threatList.end(); ++itr)
@@ -1862,7 +1862,7 @@ public:
     {
         if (Creature* l_Creature = p_Handler->getSelectedCreature())
         {
-            std::list<HostileReference*> l_Aggro = l_Creature->getThreatManager().GetThreatList();
+            ThreatContainer::StorageType l_Aggro = l_Creature->getThreatManager().GetThreatList();
 
             for (auto l_Threat : l_Aggro)
             {
@@ -19,6 +19,8 @@ EndScriptData */
 #include "Config.h"
 #include "ObjectAccessor.h"
 #include "MapManager.h"
+#include "PerfProfiler.h"
+#include "DatabaseEnv.h"
 #include <regex>
 
 class server_commandscript : public CommandScript
@@ -67,6 +69,7 @@ public:
         static ChatCommand serverCommandTable[] =
         {
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,             "", NULL },
+            { "dbqueues",       SEC_ADMINISTRATOR,  true,  &HandleServerDBQueuesCommand,            "", NULL },
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,                "", NULL },
             { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleShutdownCommandTable },
@@ -79,14 +82,107 @@ public:
             { NULL,             0,                  false, NULL,                                    "", NULL }
         };
 
+        static ChatCommand perfCommandTable[] =
+        {
+            { "show",           SEC_ADMINISTRATOR,  true,  &HandlePerfShowCommand,                  "", NULL },
+            { "enable",         SEC_ADMINISTRATOR,  true,  &HandlePerfEnableCommand,                "", NULL },
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandlePerfResetCommand,                 "", NULL },
+            { "",               SEC_ADMINISTRATOR,  true,  &HandlePerfShowCommand,                  "", NULL },
+            { NULL,             0,                  false, NULL,                                    "", NULL }
+        };
+
          static ChatCommand commandTable[] =
         {
             { "server",         SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverCommandTable },
+            { "perf",           SEC_ADMINISTRATOR,  true,  NULL,                                    "", perfCommandTable },
             { NULL,             0,                  false, NULL,                                    "", NULL }
         };
         return commandTable;
     }
 
+    /// .perf show [subsystem|map|task|opcode] [count] - timings of the current window, slowest p99 first
+    static bool HandlePerfShowCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        if (!sPerfProfiler->IsEnabled())
+        {
+            p_Handler->PSendSysMessage("Tick profiler is disabled, use .perf enable on");
+            return true;
+        }
+
+        char* l_CategoryStr = strtok((char*)p_Args, " ");
+        char* l_CountStr    = strtok(NULL, " ");
+
+        PerfCategory l_Category = PERF_CATEGORY_SUBSYSTEM;
+        if (l_CategoryStr)
+        {
+            l_Category = PERF_CATEGORY_MAX;
+            for (uint32 l_I = 0; l_I < PERF_CATEGORY_MAX; ++l_I)
+            {
+                if (!strcmp(l_CategoryStr, PerfProfiler::GetCategoryName(PerfCategory(l_I))))
+                    l_Category = PerfCategory(l_I);
+            }
+
+            if (l_Category == PERF_CATEGORY_MAX)
+            {
+                p_Handler->PSendSysMessage("Unknown category %s, use subsystem, map, task or opcode", l_CategoryStr);
+                p_Handler->SetSentErrorMessage(true);
+                return false;
+            }
+        }
+
+        uint32 l_Count = l_CountStr ? uint32(std::max(atoi(l_CountStr), 1)) : 10;
+
+        std::vector<PerfProfiler::Entry> l_Entries = sPerfProfiler->GetEntries(l_Category);
+        if (l_Entries.empty())
+        {
+            p_Handler->PSendSysMessage("No %s timing recorded yet", PerfProfiler::GetCategoryName(l_Category));
+            return true;
+        }
+
+        p_Handler->PSendSysMessage("Slowest %s (us): count avg p50 p90 p99 p99.9 max", PerfProfiler::GetCategoryName(l_Category));
+
+        for (uint32 l_I = 0; l_I < l_Entries.size() && l_I < l_Count; ++l_I)
+        {
+            PerfProfiler::Entry const& l_Entry = l_Entries[l_I];
+
+            uint64 l_SampleCount = l_Entry.Stats.Count;
+            if (!l_SampleCount)
+                continue;
+
+            p_Handler->PSendSysMessage("%s: " UI64FMTD " " UI64FMTD " %u %u %u %u %u", l_Entry.Name.c_str(), l_SampleCount, l_Entry.Stats.Sum / l_SampleCount,
+                l_Entry.Stats.P50, l_Entry.Stats.P90, l_Entry.Stats.P99, l_Entry.Stats.P999, l_Entry.Stats.Max);
+        }
+
+        return true;
+    }
+
+    static bool HandlePerfEnableCommand(ChatHandler* p_Handler, char const* p_Args)
+    {
+        if (!*p_Args)
+        {
+            p_Handler->PSendSysMessage("Tick profiler is %s", sPerfProfiler->IsEnabled() ? "enabled" : "disabled");
+            return true;
+        }
+
+        std::string l_Arg = p_Args;
+        if (l_Arg == "on")
+            sPerfProfiler->SetEnabled(true);
+        else if (l_Arg == "off")
+            sPerfProfiler->SetEnabled(false);
+        else
+            return false;
+
+        p_Handler->PSendSysMessage("Tick profiler %s", sPerfProfiler->IsEnabled() ? "enabled" : "disabled");
+        return true;
+    }
+
+    static bool HandlePerfResetCommand(ChatHandler* p_Handler, char const* /*args*/)
+    {
+        sPerfProfiler->Reset();
+        p_Handler->PSendSysMessage("Tick profiler window reset");
+        return true;
+    }
+
     // Triggering corpses expire check in world
     static bool HandleServerCorpsesCommand(ChatHandler* /*handler*/, char const* /*args*/)
     {
@@ -94,6 +190,34 @@ public:
         return true;
     }
 
+    /// One line per asynchronous worker queue of p_Pool : depth, processed operations, average and max wait, average execution time
+    template<class T>
+    static void SendDatabaseQueueStats(ChatHandler* p_Handler, char const* p_Name, DatabaseWorkerPool<T>& p_Pool)
+    {
+        p_Handler->PSendSysMessage("%s: %u queues%s", p_Name, uint32(p_Pool.GetQueueCount()), p_Pool.IsBackPressured() ? ", back pressured" : "");
+
+        for (size_t l_I = 0; l_I < p_Pool.GetQueueCount(); ++l_I)
+        {
+            SQLQueueStats const& l_Stats = p_Pool.GetQueueStats(l_I);
+
+            uint64 l_Processed = l_Stats.Processed.load(std::memory_order_relaxed);
+            uint64 l_AvgWait   = l_Processed ? l_Stats.TotalWaitTime.load(std::memory_order_relaxed) / l_Processed : 0;
+            uint64 l_AvgExec   = l_Processed ? l_Stats.TotalExecTime.load(std::memory_order_relaxed) / l_Processed : 0;
+
+            p_Handler->PSendSysMessage("  #%u: depth %u, processed " UI64FMTD ", wait avg " UI64FMTD " ms max %u ms, exec avg " UI64FMTD " ms",
+                uint32(l_I), l_Stats.Depth.load(std::memory_order_relaxed), l_Processed, l_AvgWait, l_Stats.MaxWaitTime.load(std::memory_order_relaxed), l_AvgExec);
+        }
+    }
+
+    /// .server dbqueues - load of the asynchronous database worker queues
+    static bool HandleServerDBQueuesCommand(ChatHandler* p_Handler, char const* /*args*/)
+    {
+        SendDatabaseQueueStats(p_Handler, "CharacterDatabase", CharacterDatabase);
+        SendDatabaseQueueStats(p_Handler, "WorldDatabase", WorldDatabase);
+        SendDatabaseQueueStats(p_Handler, "LoginDatabase", LoginDatabase);
+        return true;
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* p_Handler, char const* /*args*/)
     {
 #ifndef CROSS
@@ -752,16 +752,16 @@ class boss_blackhand : public CreatureScript
                         if (m_PhaseID != ePhases::StorageWarehouse)
                             break;
 
-                        std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                        ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                         if (!l_ThreatList.empty())
                         {
-                            l_ThreatList.remove_if([this](HostileReference* p_Ref) -> bool
+                            l_ThreatList.erase(std::remove_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_Ref) -> bool
                             {
                                 if (p_Ref == nullptr || p_Ref->getTarget() == nullptr || !p_Ref->getTarget()->IsPlayer())
                                     return true;
 
                                 return false;
-                            });
+                            }), l_ThreatList.end());
                         }
 
                         for (HostileReference* l_Ref : l_ThreatList)
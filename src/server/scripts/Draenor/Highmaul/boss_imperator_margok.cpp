@@ -880,7 +880,7 @@ class boss_imperator_margok : public CreatureScript
                     }
                     case eCosmeticEvents::EventCheckPlayerZ:
                     {
-                        std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                        ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                         for (HostileReference* l_Ref : l_ThreatList)
                         {
                             if (Player* l_Player = Player::GetPlayer(*me, l_Ref->getUnitGuid()))
@@ -1123,7 +1123,7 @@ class boss_imperator_margok : public CreatureScript
                     if (l_Trigger = me->GetAreaTrigger(eSpells::ForceNovaAreaTrigger))
                         l_TriggerGuid = l_Trigger->GetGUID();
 
-                    std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                    ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                     for (HostileReference* l_Ref : l_ThreatList)
                     {
                         if (Player* l_Player = Player::GetPlayer(*me, l_Ref->getUnitGuid()))
@@ -1174,7 +1174,7 @@ class boss_imperator_margok : public CreatureScript
 
                             l_MinRadius += (l_YardsPerMs * m_NovaTimePhase3[l_I]);
 
-                            std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                            ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                             for (HostileReference* l_Ref : l_ThreatList)
                             {
                                 if (Player* l_Player = Player::GetPlayer(*me, l_Ref->getUnitGuid()))
@@ -1187,7 +1187,7 @@ class boss_imperator_margok : public CreatureScript
                         }
                     }
 
-                    std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                    ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                     for (HostileReference* l_Ref : l_ThreatList)
                     {
                         if (Player* l_Player = Player::GetPlayer(*me, l_Ref->getUnitGuid()))
@@ -101,7 +101,7 @@ class boss_rukhmar : public CreatureScript
             {
                 if (p_Damage > me->GetHealth())
                 {
-                    std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                    ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
 
                     for (HostileReference* l_Ref : l_ThreatList)
                     {
@@ -188,7 +188,7 @@ class boss_rukhmar : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -355,7 +355,7 @@ class npc_energized_phoenix : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
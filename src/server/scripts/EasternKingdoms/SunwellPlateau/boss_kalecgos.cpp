@@ -292,9 +292,9 @@ public:
 
                 if (SpectralBlastTimer <= diff)
                 {
-                    std::list<HostileReference*> &m_threatlist = me->getThreatManager().getThreatList();
+                    ThreatContainer::StorageType m_threatlist = me->getThreatManager().getThreatList();
                     std::list<Unit*> targetList;
-                    for (std::list<HostileReference*>::const_iterator itr = m_threatlist.begin(); itr!= m_threatlist.end(); ++itr)
+                    for (ThreatContainer::StorageType::const_iterator itr = m_threatlist.begin(); itr!= m_threatlist.end(); ++itr)
                         if ((*itr)->getTarget() && (*itr)->getTarget()->IsPlayer() && (*itr)->getTarget()->GetGUID() != me->getVictim()->GetGUID() && !(*itr)->getTarget()->HasAura(AURA_SPECTRAL_EXHAUSTION) && (*itr)->getTarget()->GetPositionZ() > me->GetPositionZ()-5)
                             targetList.push_back((*itr)->getTarget());
                     if (targetList.empty())
@@ -743,7 +743,8 @@ public:
 
             if (ResetThreat <= diff)
             {
-                for (std::list<HostileReference*>::const_iterator itr = me->getThreatManager().getThreatList().begin(); itr != me->getThreatManager().getThreatList().end(); ++itr)
+                ThreatContainer::StorageType threatList = me->getThreatManager().getThreatList();
+                for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                 {
                     if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                     {
@@ -558,7 +558,7 @@ class npc_green_dragon_combat_trigger : public CreatureScript
                 if (!me->isInCombat())
                     return;
 
-                std::list<HostileReference*> const& threatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType const& threatList = me->getThreatManager().getThreatList();
                 if (threatList.empty())
                 {
                     EnterEvadeMode();
@@ -571,7 +571,7 @@ class npc_green_dragon_combat_trigger : public CreatureScript
                     return;
 
                 // check if there is any player on threatlist, if not - evade
-                for (std::list<HostileReference*>::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                     if (Unit* target = (*itr)->getTarget())
                         if (target->IsPlayer())
                             return; // found any player, return
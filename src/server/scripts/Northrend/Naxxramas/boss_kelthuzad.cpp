@@ -597,8 +597,8 @@ public:
                         case EVENT_DETONATE:
                         {
                             std::vector<Unit*> unitList;
-                            std::list<HostileReference*> *threatList = &me->getThreatManager().getThreatList();
-                            for (std::list<HostileReference*>::const_iterator itr = threatList->begin(); itr != threatList->end(); ++itr)
+                            ThreatContainer::StorageType *threatList = &me->getThreatManager().getThreatList();
+                            for (ThreatContainer::StorageType::const_iterator itr = threatList->begin(); itr != threatList->end(); ++itr)
                             {
                                 if ((*itr)->getTarget()->IsPlayer()
                                     && (*itr)->getTarget()->getPowerType() == POWER_MANA
@@ -1882,8 +1882,9 @@ class spell_malygos_vortex_visual: public SpellScriptLoader
             {
                 if (Creature* caster = GetCaster()->ToCreature())
                 {
-                    const std::list<HostileReference*>& m_threatlist = caster->getThreatManager().getThreatList();
-                    for (std::list<HostileReference*>::const_iterator itr = m_threatlist.begin(); itr!= m_threatlist.end(); ++itr)
+                    // copy, the casts below can change the threat list
+                    ThreatContainer::StorageType m_threatlist = caster->getThreatManager().getThreatList();
+                    for (ThreatContainer::StorageType::const_iterator itr = m_threatlist.begin(); itr!= m_threatlist.end(); ++itr)
                     {
                         if (Unit* target = (*itr)->getTarget())
                         {
@@ -183,7 +183,7 @@ public:
                             case 3: Healer = CLASS_DRUID; break;
                             case 4: Healer = CLASS_SHAMAN; break;
                         }
-                        std::list<HostileReference*>::const_iterator i = me->getThreatManager().getThreatList().begin();
+                        ThreatContainer::StorageType::const_iterator i = me->getThreatManager().getThreatList().begin();
                         for (; i != me->getThreatManager().getThreatList().end(); ++i)
                         {
                             Unit* temp = Unit::GetUnit(*me, (*i)->getUnitGuid());
@@ -842,8 +842,8 @@ public:
             if (me->getVictim() && me->getVictim()->GetPositionZ() >= 286.276f)
             {
                 bool evadeMode = false;
-                std::list<HostileReference*> t_list = me->getThreatManager().getThreatList();
-                for (std::list<HostileReference*>::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
+                ThreatContainer::StorageType t_list = me->getThreatManager().getThreatList();
+                for (ThreatContainer::StorageType::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
                 {
                     if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                     {
@@ -973,8 +973,8 @@ public:
             {
                 if (victim->GetPositionZ() >= 286.276f)
                 {
-                    std::list<HostileReference*> t_list = me->getThreatManager().getThreatList();
-                    for (std::list<HostileReference*>::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
+                    ThreatContainer::StorageType t_list = me->getThreatManager().getThreatList();
+                    for (ThreatContainer::StorageType::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
                     {
                         if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                         {
@@ -1123,8 +1123,8 @@ public:
             if (me->getVictim() && me->getVictim()->GetPositionZ() >= 286.276f)
             {
                 bool evadeMode = false;
-                std::list<HostileReference*> t_list = me->getThreatManager().getThreatList();
-                for (std::list<HostileReference*>::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
+                ThreatContainer::StorageType t_list = me->getThreatManager().getThreatList();
+                for (ThreatContainer::StorageType::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
                 {
                     if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                     {
@@ -275,7 +275,7 @@ class npc_faction_boss : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -616,7 +616,7 @@ class npc_ashran_korlok : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -813,7 +813,7 @@ class npc_ashran_faction_champions : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -921,7 +921,7 @@ class npc_ashran_mandragoraster : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -1009,7 +1009,7 @@ class npc_ashran_panthora : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -1122,7 +1122,7 @@ class npc_ashran_ancient_inferno : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -1241,7 +1241,7 @@ class npc_ashran_goregore : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -1466,7 +1466,7 @@ class npc_ashran_elder_darkweaver_kath : public CreatureScript
 
             void HandleHealthAndDamageScaling()
             {
-                std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
                 uint32 l_Count = (uint32)std::count_if(l_ThreatList.begin(), l_ThreatList.end(), [this](HostileReference* p_HostileRef) -> bool
                 {
                     Unit* l_Unit = Unit::GetUnit(*me, p_HostileRef->getUnitGuid());
@@ -133,13 +133,13 @@ public:
         void CastBloodboil()
         {
             // Get the Threat List
-            std::list<HostileReference*> m_threatlist = me->getThreatManager().getThreatList();
+            ThreatContainer::StorageType m_threatlist = me->getThreatManager().getThreatList();
 
             if (m_threatlist.empty()) // He doesn't have anyone in his threatlist, useless to continue
                 return;
 
             std::list<Unit*> targets;
-            std::list<HostileReference*>::const_iterator itr = m_threatlist.begin();
+            ThreatContainer::StorageType::const_iterator itr = m_threatlist.begin();
             for (; itr!= m_threatlist.end(); ++itr)             //store the threat list in a different container
             {
                 Unit* target = Unit::GetUnit(*me, (*itr)->getUnitGuid());
@@ -791,10 +791,10 @@ public:
             // some code to cast spell Mana Burn on random target which has mana
             if (ManaBurnTimer <= diff)
             {
-                std::list<HostileReference*> AggroList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType AggroList = me->getThreatManager().getThreatList();
                 std::list<Unit*> UnitsWithMana;
 
-                for (std::list<HostileReference*>::const_iterator itr = AggroList.begin(); itr != AggroList.end(); ++itr)
+                for (ThreatContainer::StorageType::const_iterator itr = AggroList.begin(); itr != AggroList.end(); ++itr)
                 {
                     if (Unit* unit = Unit::GetUnit(*me, (*itr)->getUnitGuid()))
                     {
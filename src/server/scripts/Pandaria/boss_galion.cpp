@@ -203,8 +203,8 @@ class boss_galion : public CreatureScript
             {
                 if (p_Damage >= me->GetHealth())
                 {
-                    std::list<HostileReference*> l_ThreatList = me->getThreatManager().getThreatList();
-                    for (std::list<HostileReference*>::const_iterator l_Itr = l_ThreatList.begin(); l_Itr != l_ThreatList.end(); ++l_Itr)
+                    ThreatContainer::StorageType l_ThreatList = me->getThreatManager().getThreatList();
+                    for (ThreatContainer::StorageType::const_iterator l_Itr = l_ThreatList.begin(); l_Itr != l_ThreatList.end(); ++l_Itr)
                     {
                         if (Player* l_Player = Player::GetPlayer(*me, (*l_Itr)->getUnitGuid()))
                             m_LootersGuids.push_back(l_Player->GetGUID());
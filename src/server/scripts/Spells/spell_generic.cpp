@@ -4081,7 +4081,7 @@ class spell_inherit_master_threat_list : public SpellScriptLoader
                     if (Creature* l_Target = GetHitUnit()->ToCreature())
                     {
                         l_Target->getThreatManager().clearReferences();
-                        std::list<HostileReference*>& l_PlayerThreatManager = l_Caster->getThreatManager().getThreatList();
+                        ThreatContainer::StorageType l_PlayerThreatManager = l_Caster->getThreatManager().getThreatList();
                         for (HostileReference* l_Threat : l_PlayerThreatManager)
                         {
                             if (Unit* l_Obj = Unit::GetUnit(*l_Target, l_Threat->getUnitGuid()))
@@ -13,129 +13,83 @@ DB2FileLoader::DB2FileLoader()
 {
     data = NULL;
     fieldsOffset = NULL;
+    file = NULL;
 }
 
 bool DB2FileLoader::Load(const char *filename, const char *fmt)
 {
-    uint32 header = 48;
-    if (data)
-    {
-        delete [] data;
-        data=NULL;
-    }
-
-    FILE * f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Signature
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(header);
-
-    if (header != 0x32424457)
-    {
-        fclose(f);
-        return false;                                       //'WDB2'
-    }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                 // Number of records
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(recordCount);
+    delete file;
+    file = NULL;
+    data = NULL;
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                 // Number of fields
+    /// The file is mapped instead of read, records and strings are used in place
+    MappedFile* mapped = new MappedFile();
+    if (!mapped->Open(filename) || mapped->GetSize() < 8 * sizeof(uint32))
     {
-        fclose(f);
+        delete mapped;
         return false;
     }
 
-    EndianConvert(fieldCount);
-
-    if (fread(&recordSize, 4, 1, f) != 1)                 // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
+    uint32 header[12];
+    memset(header, 0, sizeof(header));
+    memcpy(header, mapped->GetData(), 8 * sizeof(uint32));
 
-    EndianConvert(recordSize);
+    for (uint8 i = 0; i < 8; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                 // String size
+    if (header[0] != 0x32424457)                            //'WDB2'
     {
-        fclose(f);
+        delete mapped;
         return false;
     }
 
-    EndianConvert(stringSize);
+    recordCount = header[1];                                // Number of records
+    fieldCount  = header[2];                                // Number of fields
+    recordSize  = header[3];                                // Size of a record
+    stringSize  = header[4];                                // String size
+    tableHash   = header[5];                                // Table hash
+    build       = header[6];                                // Build
+    unk1        = header[7];                                // Unknown WDB2
+    unk2        = 0;
+    maxIndex    = 0;
+    locale      = 0;
+    unk5        = 0;
 
-    /* NEW WDB2 FIELDS*/
-    if (fread(&tableHash, 4, 1, f) != 1)                  // Table hash
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(tableHash);
-
-    if (fread(&build, 4, 1, f) != 1)                     // Build
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(build);
-
-    if (fread(&unk1, 4, 1, f) != 1)                     // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(unk1);
+    uint64 position = 8 * sizeof(uint32);
 
     if (build > 12880)
     {
-        if (fread(&unk2, 4, 1, f) != 1)                // Unknown WDB2
+        if (mapped->GetSize() < sizeof(header))
         {
-            fclose(f);
+            delete mapped;
             return false;
         }
-        EndianConvert(unk2);
 
-        if (fread(&maxIndex, 4, 1, f) != 1)                           // MaxIndex WDB2
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(maxIndex);
+        memcpy(&header[8], mapped->GetData() + position, 4 * sizeof(uint32));
+        position += 4 * sizeof(uint32);
 
-        if (fread(&locale, 4, 1, f) != 1)                             // Locales
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(locale);
+        for (uint8 i = 8; i < 12; ++i)
+            EndianConvert(header[i]);
 
-        if (fread(&unk5, 4, 1, f) != 1)                               // Unknown WDB2
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(unk5);
+        unk2     = header[8];                               // Unknown WDB2
+        maxIndex = header[9];                               // MaxIndex WDB2
+        locale   = header[10];                              // Locales
+        unk5     = header[11];                              // Unknown WDB2
     }
 
     if (maxIndex != 0)
     {
         int32 diff = maxIndex - unk2 + 1;
-        fseek(f, diff * 4 + diff * 2, SEEK_CUR);    // diff * 4: an index for rows, diff * 2: a memory allocation bank
+        position += diff * 4 + diff * 2;                    // diff * 4: an index for rows, diff * 2: a memory allocation bank
     }
 
+    if (position + uint64(recordSize) * recordCount + stringSize > mapped->GetSize())
+    {
+        delete mapped;
+        return false;
+    }
+
+    delete [] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; i++)
@@ -147,27 +101,29 @@ bool DB2FileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
+    file = mapped;
+    data = mapped->GetData() + position;
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
     return true;
 }
 
 DB2FileLoader::~DB2FileLoader()
 {
-    if (data)
-        delete [] data;
+    delete file;
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
 
+MappedFile* DB2FileLoader::ReleaseFile()
+{
+    MappedFile* mapped = file;
+    file = NULL;
+    data = NULL;
+    stringTable = NULL;
+    return mapped;
+}
+
 DB2FileLoader::Record DB2FileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -363,8 +319,8 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool= new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    /// Strings stay in the mapped file, see ReleaseFile
+    char* stringPool = (char*)stringTable;
 
     uint32 offset = 0;
 
@@ -11,6 +11,7 @@
 
 #include "Define.h"
 #include "Utilities/ByteConverter.h"
+#include "MappedFile.h"
 #include <cassert>
 
 class DB2FileLoader
@@ -71,7 +72,10 @@ class DB2FileLoader
     bool IsLoaded() const { return (data != NULL); }
     char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, std::set<LocalizedString*> & p_LocalizedString);
     char* AutoProduceStringsArrayHolders(const char* fmt, char* dataTable, uint32 p_Locale);
+    /// Returned pool points into the mapped file, it must be kept alive with ReleaseFile
     char* AutoProduceStrings(const char* fmt, char* dataTable, uint32 p_Locale);
+    /// Give the ownership of the mapped file to the caller, the loader can't be used anymore
+    MappedFile* ReleaseFile();
     static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     static uint32 GetFormatStringsFields(const char * format);
 private:
@@ -83,6 +87,7 @@ private:
     uint32 *fieldsOffset;
     unsigned char *data;
     unsigned char *stringTable;
+    MappedFile* file;
 
     // WDB2 / WCH2 fields
     uint32 tableHash;    // WDB2
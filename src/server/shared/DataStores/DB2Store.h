@@ -162,6 +162,7 @@ class DB2StorageBase
 template<class T> class DB2Storage : public DB2StorageBase
 {
     using StringPoolList = std::list<char*>;
+    using MappedFileList = std::list<MappedFile*>;
     using DataTableEx = std::vector<T*>;
 
     public:
@@ -281,7 +282,8 @@ template<class T> class DB2Storage : public DB2StorageBase
 
             m_DataTable = (T*)l_DB2Reader.AutoProduceData(m_Format, m_MaxID, (char**&)m_IndexTable, m_LocalizedString);         ///< Load raw non-string data
             m_StringPoolList.push_back(l_DB2Reader.AutoProduceStringsArrayHolders(m_Format, (char*)m_DataTable, p_Locale));     ///< Create string holders for loaded string fields
-            m_StringPoolList.push_back(l_DB2Reader.AutoProduceStrings(m_Format, (char*)m_DataTable, p_Locale));                 ///< Load strings from dbc data
+            l_DB2Reader.AutoProduceStrings(m_Format, (char*)m_DataTable, p_Locale);                                             ///< Load strings from dbc data, they stay in the mapped file
+            m_MappedFiles.push_back(l_DB2Reader.ReleaseFile());
 
             /// Insert SQL data into arrays
             if (l_SQLQueryResult)
@@ -336,8 +338,7 @@ template<class T> class DB2Storage : public DB2StorageBase
 
                                         LocalizedString * l_LocalizedString = *((LocalizedString**)(&l_WritePtr[l_WritePosition]));
 
-                                        // Beginning of the pool - empty string
-                                        l_LocalizedString->Str[LOCALE_enUS] = m_StringPoolList.back();
+                                        l_LocalizedString->Str[LOCALE_enUS] = "";
                                         l_WritePosition += sizeof(LocalizedString*);
                                         break;
                                 }
@@ -570,8 +571,7 @@ template<class T> class DB2Storage : public DB2StorageBase
 
                                     LocalizedString * l_LocalizedString = *((LocalizedString**)(&l_WritePtr[l_WritePosition]));
 
-                                    // Beginning of the pool - empty string
-                                    l_LocalizedString->Str[LOCALE_enUS] = m_StringPoolList.back();
+                                    l_LocalizedString->Str[LOCALE_enUS] = "";
                                     l_WritePosition += sizeof(LocalizedString*);
                                     break;
                             }
@@ -736,7 +736,8 @@ template<class T> class DB2Storage : public DB2StorageBase
             m_DB2FileName = p_FileName;
 
             /// load strings from another locale dbc data
-            m_StringPoolList.push_back(l_DB2Reader.AutoProduceStrings(m_Format, (char*)m_DataTable));
+            l_DB2Reader.AutoProduceStrings(m_Format, (char*)m_DataTable);
+            m_MappedFiles.push_back(l_DB2Reader.ReleaseFile());
 
             return true;
         }
@@ -768,6 +769,12 @@ template<class T> class DB2Storage : public DB2StorageBase
                 m_StringPoolList.pop_front();
             }
 
+            while (!m_MappedFiles.empty())
+            {
+                delete m_MappedFiles.front();
+                m_MappedFiles.pop_front();
+            }
+
             m_MaxID = 0;
 
             if (m_SQL)
@@ -784,6 +791,7 @@ template<class T> class DB2Storage : public DB2StorageBase
         T* m_DataTable;
         DataTableEx m_DataTableEx;
         StringPoolList m_StringPoolList;
+        MappedFileList m_MappedFiles;                                   ///< Files the string fields point into
         std::list<std::string> m_CustomStrings;
         std::set<LocalizedString*> m_LocalizedString;
         SqlDb2 * m_SQL;
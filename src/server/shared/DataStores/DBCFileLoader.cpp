@@ -10,71 +10,49 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : fieldsOffset(NULL), data(NULL), stringTable(NULL)
+DBCFileLoader::DBCFileLoader() : fieldsOffset(NULL), data(NULL), stringTable(NULL), file(NULL)
 {
 
 }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = NULL;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
-        return false;
-    }
-
+    delete file;
+    file = NULL;
+    data = NULL;
 
-    EndianConvert(header);
-
-    if (header != 0x43424457)                                //'WDBC'
+    /// The file is mapped instead of read, records and strings are used in place
+    MappedFile* mapped = new MappedFile();
+    if (!mapped->Open(filename) || mapped->GetSize() < 5 * sizeof(uint32))
     {
-        fclose(f);
+        delete mapped;
         return false;
     }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
-        return false;
-    }
+    uint32 header[5];
+    memcpy(header, mapped->GetData(), sizeof(header));
 
-    EndianConvert(recordCount);
+    for (uint8 i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
+    if (header[0] != 0x43424457)                             //'WDBC'
     {
-        fclose(f);
+        delete mapped;
         return false;
     }
 
-    EndianConvert(fieldCount);
+    recordCount = header[1];                                // Number of records
+    fieldCount = header[2];                                 // Number of fields
+    recordSize = header[3];                                 // Size of a record
+    stringSize = header[4];                                 // String size
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
+    if (uint64(sizeof(header)) + uint64(recordSize) * recordCount + stringSize > mapped->GetSize())
     {
-        fclose(f);
+        delete mapped;
         return false;
     }
 
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(stringSize);
-
+    delete [] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -86,29 +64,30 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    file = mapped;
+    data = mapped->GetData() + sizeof(header);
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
-        delete [] data;
+    delete file;
 
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
 
+MappedFile* DBCFileLoader::ReleaseFile()
+{
+    MappedFile* mapped = file;
+    file = NULL;
+    data = NULL;
+    stringTable = NULL;
+    return mapped;
+}
+
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -263,8 +242,8 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    /// Strings stay in the mapped file, see ReleaseFile
+    char* stringPool = (char*)stringTable;
 
     uint32 offset = 0;
 
@@ -11,6 +11,7 @@
 #include "Define.h"
 #include "Common.h"
 #include "Utilities/ByteConverter.h"
+#include "MappedFile.h"
 
 #include <cassert>
 
@@ -72,7 +73,10 @@ class DBCFileLoader
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
+        /// Returned pool points into the mapped file, it must be kept alive with ReleaseFile
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        /// Give the ownership of the mapped file to the caller, the loader can't be used anymore
+        MappedFile* ReleaseFile();
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
 
@@ -83,5 +87,6 @@ class DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        MappedFile* file;
 };
 #endif
@@ -58,7 +58,7 @@ struct SqlDbc
 template<class T>
 class DBCStorage
 {
-    typedef std::list<char*> StringPoolList;
+    typedef std::list<MappedFile*> MappedFileList;
     public:
         explicit DBCStorage(const char *f) :
             fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
@@ -124,7 +124,9 @@ class DBCStorage
 
             m_LastEntry = nCount;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            // Strings point into the mapped file, it is kept until the store is cleared
+            char* stringPool = dbc.AutoProduceStrings(fmt, (char*)dataTable);
+            mappedFiles.push_back(dbc.ReleaseFile());
 
             // Insert sql data into arrays
             if (result)
@@ -174,7 +176,7 @@ class DBCStorage
                                         break;
                                     case FT_STRING:
                                         // Beginning of the pool - empty string
-                                        *((char**)(&sqlDataTable[offset]))=stringPoolList.back();
+                                        *((char**)(&sqlDataTable[offset]))=stringPool;
                                         offset+=sizeof(char*);
                                         break;
                                 }
@@ -242,7 +244,8 @@ class DBCStorage
             if (!dbc.Load(fn, fmt))
                 return false;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            dbc.AutoProduceStrings(fmt, (char*)dataTable);
+            mappedFiles.push_back(dbc.ReleaseFile());
 
             return true;
         }
@@ -257,10 +260,10 @@ class DBCStorage
             delete[] ((char*)dataTable);
             dataTable = NULL;
 
-            while (!stringPoolList.empty())
+            while (!mappedFiles.empty())
             {
-                delete[] stringPoolList.front();
-                stringPoolList.pop_front();
+                delete mappedFiles.front();
+                mappedFiles.pop_front();
             }
             nCount = 0;
             m_LastEntry = 0;
@@ -286,7 +289,7 @@ class DBCStorage
         indexTable;
 
         T* dataTable;
-        StringPoolList stringPoolList;
+        MappedFileList mappedFiles;
 };
 
 #endif
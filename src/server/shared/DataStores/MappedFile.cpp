@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile() : m_Data(NULL), m_Size(0), m_File(INVALID_HANDLE_VALUE), m_Mapping(NULL)
+#else
+MappedFile::MappedFile() : m_Data(NULL), m_Size(0)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(char const* p_FileName)
+{
+    Close();
+
+#ifdef _WIN32
+    m_File = CreateFileA(p_FileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_File == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER l_Size;
+    if (!GetFileSizeEx(m_File, &l_Size) || !l_Size.QuadPart)
+    {
+        Close();
+        return false;
+    }
+
+    m_Mapping = CreateFileMappingA(m_File, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!m_Mapping)
+    {
+        Close();
+        return false;
+    }
+
+    m_Data = (unsigned char*)MapViewOfFile(m_Mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!m_Data)
+    {
+        Close();
+        return false;
+    }
+
+    m_Size = size_t(l_Size.QuadPart);
+#else
+    int l_File = open(p_FileName, O_RDONLY);
+    if (l_File < 0)
+        return false;
+
+    struct stat l_Stat;
+    if (fstat(l_File, &l_Stat) || !l_Stat.st_size)
+    {
+        close(l_File);
+        return false;
+    }
+
+    /// Writable private mapping, the rare in place fixes of the loaded data only copy the touched pages
+    void* l_Data = mmap(NULL, size_t(l_Stat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, l_File, 0);
+    close(l_File);
+
+    if (l_Data == MAP_FAILED)
+        return false;
+
+    m_Data = (unsigned char*)l_Data;
+    m_Size = size_t(l_Stat.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (m_Data)
+        UnmapViewOfFile(m_Data);
+
+    if (m_Mapping)
+        CloseHandle(m_Mapping);
+
+    if (m_File != INVALID_HANDLE_VALUE)
+        CloseHandle(m_File);
+
+    m_Mapping = NULL;
+    m_File = INVALID_HANDLE_VALUE;
+#else
+    if (m_Data)
+        munmap(m_Data, m_Size);
+#endif
+
+    m_Data = NULL;
+    m_Size = 0;
+}
@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  MILLENIUM-STUDIO
+//  Copyright 2016 Millenium-studio SARL
+//  All Rights Reserved.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "Define.h"
+
+/// Private copy-on-write mapping of a whole file
+/// Pages are shared with the page cache (and every process mapping the same file) until they are written
+class MappedFile
+{
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        bool Open(char const* p_FileName);
+        void Close();
+
+        unsigned char* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        MappedFile(MappedFile const&);
+        MappedFile& operator=(MappedFile const&);
+
+        unsigned char* m_Data;
+        size_t m_Size;
+
+#ifdef _WIN32
+        void* m_File;
+        void* m_Mapping;
+#endif
+};
+
+#endif
@@ -41,13 +41,9 @@ class DatabaseWorkerPool
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _backPressureDepth(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
-            
-            /// Update queue size limit, 16 kb is not enough
-            _queue->queue()->high_water_mark(8 * 1024 * 1024);
-            _queue->queue()->low_water_mark(8 * 1024 * 1024);
 
             WPFatal (mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
         }
@@ -64,11 +60,22 @@ class DatabaseWorkerPool
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Opening DatabasePool '%s'. Asynchronous connections: %u, synchronous connections: %u.",
                 GetDatabaseName(), async_threads, synch_threads);
 
-            //! Open asynchronous connections (delayed operations)
+            //! Open asynchronous connections (delayed operations), each one owns its queue
             _connections[IDX_ASYNC].resize(async_threads);
+            _queues.resize(async_threads);
+            _queueStats.resize(async_threads);
             for (uint8 i = 0; i < async_threads; ++i)
             {
-                T* t = new T(_queue, _connectionInfo);
+                ACE_Activation_Queue* l_Queue = new ACE_Activation_Queue();
+
+                /// Update queue size limit, 16 kb is not enough
+                l_Queue->queue()->high_water_mark(8 * 1024 * 1024);
+                l_Queue->queue()->low_water_mark(8 * 1024 * 1024);
+
+                _queues[i] = l_Queue;
+                _queueStats[i] = new SQLQueueStats();
+
+                T* t = new T(l_Queue, _connectionInfo);
                 res &= t->Open();
                 _connections[IDX_ASYNC][i] = t;
                 ++_connectionCount[IDX_ASYNC];
@@ -100,7 +107,8 @@ class DatabaseWorkerPool
             //! Shuts down delaythreads for this connection pool by underlying deactivate().
             //! The next dequeue attempt in the worker thread tasks will result in an error,
             //! ultimately ending the worker thread task.
-            _queue->queue()->close();
+            for (ACE_Activation_Queue* l_Queue : _queues)
+                l_Queue->queue()->close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -121,8 +129,15 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
                 _connections[IDX_SYNCH][i]->Close();
 
-            //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
-            delete _queue;
+            //! Deletes the ACE_Activation_Queue objects and their underlying ACE_Message_Queue
+            for (size_t i = 0; i < _queues.size(); ++i)
+            {
+                delete _queues[i];
+                delete _queueStats[i];
+            }
+
+            _queues.clear();
+            _queueStats.clear();
 
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "All connections on DatabasePool '%s' closed.", GetDatabaseName());
         }
@@ -160,7 +175,8 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement* stmt)
+        //! Operations sharing a non zero ordering key are executed in the order they were enqueued.
+        void Execute(PreparedStatement* stmt, uint64 p_OrderingKey = 0)
         {
             if (stmt->getIndex() == 0)
             {
@@ -171,7 +187,7 @@ class DatabaseWorkerPool
             }
 
             PreparedStatementTask* task = new PreparedStatementTask(stmt);
-            Enqueue(task);
+            Enqueue(task, p_OrderingKey);
         }
 
         /**
@@ -358,7 +374,8 @@ class DatabaseWorkerPool
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt)
+        //! Operations sharing a non zero ordering key are executed in the order they were enqueued.
+        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, uint64 p_OrderingKey = 0)
         {
             if (stmt->getIndex() == 0)
             {
@@ -370,14 +387,15 @@ class DatabaseWorkerPool
 
             PreparedQueryResultFuture res;
             PreparedStatementTask* task = new PreparedStatementTask(stmt, res);
-            Enqueue(task);
+            Enqueue(task, p_OrderingKey);
             return res;
         }
 
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, std::function<void(PreparedQueryResult)> p_Callback)
+        //! Operations sharing a non zero ordering key are executed in the order they were enqueued.
+        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, std::function<void(PreparedQueryResult)> p_Callback, uint64 p_OrderingKey = 0)
         {
             if (stmt->getIndex() == 0)
             {
@@ -389,7 +407,7 @@ class DatabaseWorkerPool
 
             PreparedQueryResultFuture res;
             PreparedStatementTask* task = new PreparedStatementTask(stmt, res);
-            Enqueue(task);
+            Enqueue(task, p_OrderingKey);
 
             # ifdef GAME_SERVER_PROJECTS
                 sWorld->AddPrepareStatementCallback(std::make_pair(p_Callback, res));
@@ -402,11 +420,12 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder)
+        //! Operations sharing a non zero ordering key are executed in the order they were enqueued.
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, uint64 p_OrderingKey = 0)
         {
             QueryResultHolderFuture res;
             SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
-            Enqueue(task);
+            Enqueue(task, p_OrderingKey);
             return res;     //! Fool compiler, has no use yet
         }
 
@@ -415,9 +434,12 @@ class DatabaseWorkerPool
         */
 
         //! Begins an automanaged transaction pointer that will automatically rollback if not commited. (Autocommit=0)
-        SQLTransaction BeginTransaction()
+        //! See Transaction::SetOrderingKey for p_OrderingKey.
+        SQLTransaction BeginTransaction(uint64 p_OrderingKey = 0)
         {
-            return SQLTransaction(new Transaction);
+            SQLTransaction l_Transaction(new Transaction);
+            l_Transaction->SetOrderingKey(p_OrderingKey);
+            return l_Transaction;
         }
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
@@ -446,7 +468,7 @@ class DatabaseWorkerPool
                 sWorld->AddTransactionCallback(p_Callback);
             #endif
 
-            Enqueue(new TransactionTask(transaction, p_Callback));
+            Enqueue(new TransactionTask(transaction, p_Callback), transaction->GetOrderingKey());
         }
 
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
@@ -552,11 +574,34 @@ class DatabaseWorkerPool
                 }
             }
 
-            //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-            //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-            //! as the sole purpose is to prevent connections from idling.
-            for (size_t i = 0; i < _connections[IDX_ASYNC].size(); ++i)
-                Enqueue(new PingOperation);
+            //! Every worker thread owns its queue, so each one receives exactly 1 ping operation request
+            for (size_t i = 0; i < _queues.size(); ++i)
+                EnqueueOn(new PingOperation, i);
+        }
+
+        //! Number of asynchronous worker queues
+        size_t GetQueueCount() const { return _queues.size(); }
+
+        //! Depth and latency counters of the given asynchronous worker queue
+        SQLQueueStats const& GetQueueStats(size_t p_Index) const { return *_queueStats[p_Index]; }
+
+        //! Depth of the deepest asynchronous queue
+        uint32 GetMaxQueueDepth() const
+        {
+            uint32 l_Depth = 0;
+            for (SQLQueueStats const* l_Stats : _queueStats)
+                l_Depth = std::max(l_Depth, l_Stats->Depth.load(std::memory_order_relaxed));
+
+            return l_Depth;
+        }
+
+        //! Queue depth above which IsBackPressured returns true, 0 to disable
+        void SetBackPressureDepth(uint32 p_Depth) { _backPressureDepth = p_Depth; }
+
+        //! Tells the producers (world thread, sessions) to delay non urgent writes because a worker can't keep up
+        bool IsBackPressured() const
+        {
+            return _backPressureDepth && GetMaxQueueDepth() >= _backPressureDepth;
         }
 
     private:
@@ -568,9 +613,49 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
-        void Enqueue(SQLOperation* op)
+        //! Keyed operations always land on the same queue so their order is kept,
+        //! the others go to the least loaded queue.
+        void Enqueue(SQLOperation* op, uint64 p_OrderingKey = 0)
+        {
+            //! Without asynchronous connection the operation runs right away on a synchronous one
+            if (_queues.empty())
+            {
+                T* l_Connection = GetFreeConnection();
+                op->SetConnection(l_Connection);
+                op->call();
+                l_Connection->Unlock();
+
+                delete op;
+                return;
+            }
+
+            if (p_OrderingKey)
+            {
+                /// Mix the key, guids are sequential and would otherwise follow the queue count pattern
+                uint64 l_Hash = p_OrderingKey * UI64LIT(0x9E3779B97F4A7C15);
+                EnqueueOn(op, size_t((l_Hash >> 32) % _queues.size()));
+                return;
+            }
+
+            size_t l_Best = 0;
+            uint32 l_BestDepth = _queueStats[0]->Depth.load(std::memory_order_relaxed);
+            for (size_t i = 1; i < _queueStats.size() && l_BestDepth; ++i)
+            {
+                uint32 l_Depth = _queueStats[i]->Depth.load(std::memory_order_relaxed);
+                if (l_Depth < l_BestDepth)
+                {
+                    l_Best = i;
+                    l_BestDepth = l_Depth;
+                }
+            }
+
+            EnqueueOn(op, l_Best);
+        }
+
+        void EnqueueOn(SQLOperation* op, size_t p_Index)
         {
-            _queue->enqueue(op);
+            op->SetQueueStats(_queueStats[p_Index]);
+            _queues[p_Index]->enqueue(op);
         }
 
         //! Gets a free connection in the synchronous connection pool.
@@ -605,7 +690,9 @@ class DatabaseWorkerPool
             IDX_SIZE
         };
 
-        ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        std::vector<ACE_Activation_Queue*> _queues;         //! One queue per async worker thread.
+        std::vector<SQLQueueStats*>     _queueStats;        //! Counters of _queues, same index.
+        uint32                          _backPressureDepth;
         std::vector<T*>                 _connections[IDX_SIZE];
         uint32                          _connectionCount[IDX_SIZE];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
@@ -119,7 +119,6 @@ enum CharacterDatabaseStatements
     CHAR_SEL_AUCTION_ITEMS,
     CHAR_INS_AUCTION,
     CHAR_DEL_AUCTION,
-    CHAR_SEL_AUCTION_BY_TIME,
     CHAR_UPD_AUCTION_BID,
     CHAR_SEL_AUCTIONS,
     CHAR_INS_MAIL,
@@ -539,8 +538,7 @@ enum CharacterDatabaseStatements
     CHAR_INS_CHAR_SKILLS,
     CHAR_UDP_CHAR_SKILLS,
     CHAR_INS_CHAR_SPELL,
-    CHAR_DEL_CHAR_STATS,
-    CHAR_INS_CHAR_STATS,
+    CHAR_REP_CHAR_STATS,
     CHAR_DEL_PETITION_BY_OWNER,
     CHAR_DEL_PETITION_SIGNATURE_BY_OWNER,
     CHAR_DEL_PETITION_BY_OWNER_AND_TYPE,
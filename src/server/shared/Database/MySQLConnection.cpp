@@ -372,6 +372,7 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
 
     BeginTransaction();
 
+    std::string batch;
     std::list<SQLElementData>::const_iterator itr;
     for (itr = queries.begin(); itr != queries.end(); ++itr)
     {
@@ -382,6 +383,22 @@ bool MySQLConnection::ExecuteTransaction(SQLTransaction& transaction)
             {
                 PreparedStatement* stmt = data.element.stmt;
                 ASSERT(stmt);
+
+                //! Consecutive rows inserted by the same statement are sent in a single round-trip
+                std::list<SQLElementData>::const_iterator next = BuildBatchQuery(itr, queries.end(), batch);
+                if (!batch.empty())
+                {
+                    if (!Execute(batch.c_str()))
+                    {
+                        sLog->outWarn(LOG_FILTER_SQL, "Transaction aborted. %u queries not executed.", (uint32)queries.size());
+                        RollbackTransaction();
+                        return false;
+                    }
+
+                    itr = --next;
+                    break;
+                }
+
                 if (!Execute(stmt))
                 {
                     sLog->outWarn(LOG_FILTER_SQL, "Transaction aborted. %u queries not executed.", (uint32)queries.size());
@@ -460,10 +477,189 @@ void MySQLConnection::PrepareStatement(uint32 index, const char* sql, Connection
         {
             MySQLPreparedStatement* mStmt = new MySQLPreparedStatement(stmt);
             m_stmts[index] = mStmt;
+
+            if (m_batchOffsets.size() < m_stmts.size())
+                m_batchOffsets.resize(m_stmts.size(), 0);
+
+            m_batchOffsets[index] = GetBatchTupleOffset(sql);
         }
     }
 }
 
+size_t MySQLConnection::GetBatchTupleOffset(const char* sql)
+{
+    const char* keywordStart = sql;
+    while (isspace(*keywordStart))
+        ++keywordStart;
+
+    if (strnicmp(keywordStart, "INSERT", 6) && strnicmp(keywordStart, "REPLACE", 7))
+        return 0;
+
+    //! "ON DUPLICATE KEY UPDATE x = VALUES(x)" and "INSERT ... SELECT" also end with a parenthesis
+    std::string upper(sql);
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    if (upper.find("DUPLICATE") != std::string::npos || upper.find("SELECT") != std::string::npos)
+        return 0;
+
+    size_t end = strlen(sql);
+    while (end && (isspace(sql[end - 1]) || sql[end - 1] == ';'))
+        --end;
+
+    if (!end || sql[end - 1] != ')')
+        return 0;
+
+    //! Find the opening parenthesis of the last tuple, quoted literals are not supported
+    size_t start = end - 1;
+    int32 depth = 0;
+    for (;; --start)
+    {
+        char c = sql[start];
+        if (c == '\'' || c == '"')
+            return 0;
+        if (c == ')')
+            ++depth;
+        else if (c == '(' && !--depth)
+            break;
+        if (!start)
+            return 0;
+    }
+
+    size_t keyword = start;
+    while (keyword && isspace(sql[keyword - 1]))
+        --keyword;
+
+    if (keyword < 6 || strnicmp(sql + keyword - 6, "VALUES", 6))
+        return 0;
+
+    return start;
+}
+
+std::list<SQLElementData>::const_iterator MySQLConnection::BuildBatchQuery(std::list<SQLElementData>::const_iterator itr, std::list<SQLElementData>::const_iterator end, std::string& query)
+{
+    query.clear();
+
+    uint32 index = itr->element.stmt->m_index;
+    size_t offset = index < m_batchOffsets.size() ? m_batchOffsets[index] : 0;
+    if (!offset)
+        return itr;
+
+    std::list<SQLElementData>::const_iterator next = itr;
+    if (++next == end || next->type != SQL_ELEMENT_PREPARED || next->element.stmt->m_index != index)
+        return itr;
+
+    const char* sql = m_queries[index].first;
+    query.assign(sql, offset);
+
+    uint32 rows = 0;
+    for (next = itr; next != end && rows < MYSQL_BATCH_MAX_ROWS && query.size() < MYSQL_BATCH_MAX_LENGTH; ++next, ++rows)
+    {
+        if (next->type != SQL_ELEMENT_PREPARED || next->element.stmt->m_index != index)
+            break;
+
+        if (rows)
+            query += ',';
+
+        if (!AppendBatchRow(query, sql + offset, next->element.stmt))
+        {
+            query.clear();
+            return itr;
+        }
+    }
+
+    return next;
+}
+
+bool MySQLConnection::AppendBatchRow(std::string& query, const char* tuple, PreparedStatement* stmt)
+{
+    std::vector<PreparedStatementData> const& values = stmt->statement_data;
+    char buffer[32];
+
+    //! Copy the tuple up to its closing parenthesis, anything after it (spaces, ';') is not part of the row
+    uint32 i = 0;
+    int32 depth = 0;
+    for (const char* c = tuple; *c; ++c)
+    {
+        if (*c != '?')
+        {
+            query += *c;
+
+            if (*c == '(')
+                ++depth;
+            else if (*c == ')' && !--depth)
+                break;
+
+            continue;
+        }
+
+        if (i >= values.size())
+            return false;
+
+        PreparedStatementData const& value = values[i++];
+        switch (value.type)
+        {
+            case TYPE_BOOL:
+                query += value.data.boolean ? '1' : '0';
+                break;
+            case TYPE_UI8:
+                query += std::to_string(uint32(value.data.ui8));
+                break;
+            case TYPE_UI16:
+                query += std::to_string(uint32(value.data.ui16));
+                break;
+            case TYPE_UI32:
+                query += std::to_string(value.data.ui32);
+                break;
+            case TYPE_UI64:
+                query += std::to_string(value.data.ui64);
+                break;
+            case TYPE_I8:
+                query += std::to_string(int32(value.data.i8));
+                break;
+            case TYPE_I16:
+                query += std::to_string(int32(value.data.i16));
+                break;
+            case TYPE_I32:
+                query += std::to_string(value.data.i32);
+                break;
+            case TYPE_I64:
+                query += std::to_string(value.data.i64);
+                break;
+            case TYPE_FLOAT:
+                if (!std::isfinite(value.data.f))
+                    return false;
+                snprintf(buffer, sizeof(buffer), "%.9g", value.data.f);
+                query += buffer;
+                break;
+            case TYPE_DOUBLE:
+                if (!std::isfinite(value.data.d))
+                    return false;
+                snprintf(buffer, sizeof(buffer), "%.17g", value.data.d);
+                query += buffer;
+                break;
+            case TYPE_STRING:
+            {
+                if (!value.data.str.ptr)
+                    return false;
+
+                std::vector<char> escaped(value.data.str.len * 2 + 1);
+                unsigned long length = mysql_real_escape_string(m_Mysql, &escaped[0], value.data.str.ptr, value.data.str.len);
+
+                query += '\'';
+                query.append(&escaped[0], length);
+                query += '\'';
+                break;
+            }
+            case TYPE_NULL:
+                query += "NULL";
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return i == values.size();
+}
+
 PreparedResultSet* MySQLConnection::Query(PreparedStatement* stmt)
 {
     MYSQL_RES *result = NULL;
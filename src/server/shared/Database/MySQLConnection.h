@@ -57,6 +57,10 @@ typedef std::map<uint32 /*index*/, std::pair<const char* /*query*/, ConnectionFl
 
 #define PREPARE_STATEMENT(a, b, c) m_queries[a] = std::make_pair(strdup(b), CONNECTION_BOTH);
 
+//! Limits of the multi-row queries built from consecutive inserts of a transaction, keep them under max_allowed_packet
+#define MYSQL_BATCH_MAX_ROWS    1000
+#define MYSQL_BATCH_MAX_LENGTH  (512 * 1024)
+
 class MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
@@ -106,12 +110,21 @@ class MySQLConnection
         MySQLPreparedStatement* GetPreparedStatement(uint32 index);
         void PrepareStatement(uint32 index, const char* sql, ConnectionFlags flags);
 
+        //! Offset of the "(?, ?, ...)" tuple ending an INSERT/REPLACE ... VALUES statement, 0 if it can't be merged with other rows
+        static size_t GetBatchTupleOffset(const char* sql);
+        //! Merge the prepared statements following itr that share its index into a single multi-row query.
+        //! Returns the first element not merged, query is left empty if there is nothing to merge.
+        std::list<SQLElementData>::const_iterator BuildBatchQuery(std::list<SQLElementData>::const_iterator itr, std::list<SQLElementData>::const_iterator end, std::string& query);
+        //! Append the tuple with the values of stmt, false if one of them can't be written as a literal
+        bool AppendBatchRow(std::string& query, const char* tuple, PreparedStatement* stmt);
+
         bool PrepareStatements();
         virtual void DoPrepareStatements() = 0;
 
     protected:
         std::vector<MySQLPreparedStatement*> m_stmts;         //! PreparedStatements storage
         PreparedStatementMap                 m_queries;       //! Query storage
+        std::vector<size_t>                  m_batchOffsets;  //! GetBatchTupleOffset of every prepared statement
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
 
@@ -119,7 +132,7 @@ class MySQLConnection
         bool _HandleMySQLErrno(uint32 errNo);
 
     private:
-        ACE_Activation_Queue* m_queue;                      //! Queue shared with other asynchronous connections.
+        ACE_Activation_Queue* m_queue;                      //! Queue owned by this asynchronous connection.
         DatabaseWorker*       m_worker;                     //! Core worker task.
         MYSQL *               m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
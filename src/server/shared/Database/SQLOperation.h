@@ -13,6 +13,8 @@
 #include <ace/Activation_Queue.h>
 
 #include "QueryResult.h"
+#include "Timer.h"
+#include <atomic>
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -47,19 +49,62 @@ union SQLResultSetUnion
 
 class MySQLConnection;
 
+/// Counters of one asynchronous worker queue, written by the worker and read by the world thread
+struct SQLQueueStats
+{
+    SQLQueueStats() : Depth(0), Processed(0), TotalWaitTime(0), MaxWaitTime(0), TotalExecTime(0) { }
+
+    std::atomic<uint32> Depth;                  ///< Operations enqueued and not executed yet
+    std::atomic<uint64> Processed;
+    std::atomic<uint64> TotalWaitTime;          ///< Milliseconds spent in the queue
+    std::atomic<uint32> MaxWaitTime;
+    std::atomic<uint64> TotalExecTime;          ///< Milliseconds spent executing
+
+    void OnEnqueue() { ++Depth; }
+
+    void OnExecuted(uint32 p_WaitTime, uint32 p_ExecTime)
+    {
+        --Depth;
+        ++Processed;
+        TotalWaitTime += p_WaitTime;
+        TotalExecTime += p_ExecTime;
+
+        uint32 l_Max = MaxWaitTime.load(std::memory_order_relaxed);
+        while (p_WaitTime > l_Max && !MaxWaitTime.compare_exchange_weak(l_Max, p_WaitTime))
+            ;
+    }
+};
+
 class SQLOperation : public ACE_Method_Request
 {
     public:
-        SQLOperation(): m_conn(NULL) {};
+        SQLOperation(): m_conn(NULL), m_QueueStats(nullptr), m_EnqueueTime(0) {};
         virtual int call()
         {
+            uint32 l_StartTime = getMSTime();
             Execute();
+
+            if (m_QueueStats)
+                m_QueueStats->OnExecuted(getMSTimeDiff(m_EnqueueTime, l_StartTime), GetMSTimeDiffToNow(l_StartTime));
+
             return 0;
         }
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        /// Called by the pool right before the operation is put in the queue of p_Stats
+        void SetQueueStats(SQLQueueStats* p_Stats)
+        {
+            m_QueueStats = p_Stats;
+            m_EnqueueTime = getMSTime();
+            p_Stats->OnEnqueue();
+        }
+
         MySQLConnection* m_conn;
+
+    private:
+        SQLQueueStats* m_QueueStats;
+        uint32 m_EnqueueTime;
 };
 
 #endif
@@ -23,7 +23,7 @@ class Transaction
     friend class DatabaseWokerPool;
 
     public:
-        Transaction() : _cleanedUp(false) {}
+        Transaction() : _cleanedUp(false), m_OrderingKey(0) {}
         ~Transaction() { Cleanup(); }
 
         void Append(PreparedStatement* statement);
@@ -32,12 +32,17 @@ class Transaction
 
         size_t GetSize() const { return m_queries.size(); }
 
+        /// Transactions sharing a non zero key (e.g. a character guid) run on the same worker queue, in commit order
+        void SetOrderingKey(uint64 p_Key) { m_OrderingKey = p_Key; }
+        uint64 GetOrderingKey() const { return m_OrderingKey; }
+
     //protected:
         void Cleanup();
         std::list<SQLElementData> m_queries;
 
     private:
         bool _cleanedUp;
+        uint64 m_OrderingKey;
 
 };
 typedef std::shared_ptr<Transaction> SQLTransaction;
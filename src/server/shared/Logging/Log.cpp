@@ -277,6 +277,18 @@ void Log::EnableDBAppenders()
 
 void Log::vlog(LogFilterType filter, LogLevel level, char const* str, va_list argptr)
 {
+    if (!worker)
+        return;
+
+    /// Most messages fit in the ring of the calling thread, no allocation nor lock is needed
+    va_list ringArgs;
+    va_copy(ringArgs, argptr);
+    bool written = worker->Write(GetLoggerByType(filter), level, filter, str, ringArgs);
+    va_end(ringArgs);
+
+    if (written)
+        return;
+
     char text[MAX_QUERY_LEN];
     vsnprintf(text, MAX_QUERY_LEN, str, argptr);
     write(new LogMessage(level, filter, text));
@@ -398,6 +410,7 @@ void Log::LoadFromConfig()
             m_logsDir.push_back('/');
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    worker->SetDropLogger(GetLoggerByType(LOG_FILTER_GENERAL));
 
     /// Init slack
     m_SlackEnable  = ConfigMgr::GetBoolDefault("Slack.Enable", false);
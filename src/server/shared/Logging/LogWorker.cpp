@@ -6,11 +6,20 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "Log.h"
 #include "LogWorker.h"
+#include "Logger.h"
+
+/// Ring of the current thread, only valid while t_LogRingGeneration matches the worker
+thread_local LogRingBuffer* t_LogRing = nullptr;
+thread_local uint32 t_LogRingGeneration = 0;
+
+static std::atomic<uint32> s_LogWorkerGeneration(0);
 
 LogWorker::LogWorker()
-    : m_queue(HIGH_WATERMARK, LOW_WATERMARK)
+    : m_queue(HIGH_WATERMARK, LOW_WATERMARK), m_RingCount(0), m_Generation(++s_LogWorkerGeneration), m_DropLogger(nullptr)
 {
+    memset(m_Rings, 0, sizeof(m_Rings));
     ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, 1);
 }
 
@@ -18,6 +27,9 @@ LogWorker::~LogWorker()
 {
     m_queue.deactivate();
     wait();
+
+    for (uint32 l_I = 0; l_I < m_RingCount; ++l_I)
+        delete m_Rings[l_I];
 }
 
 int LogWorker::enqueue(LogOperation* op)
@@ -25,13 +37,120 @@ int LogWorker::enqueue(LogOperation* op)
     return m_queue.enqueue(op);
 }
 
+LogRingBuffer* LogWorker::GetThreadRing()
+{
+    if (t_LogRingGeneration == m_Generation)
+        return t_LogRing;
+
+    std::lock_guard<std::mutex> l_Guard(m_RingsLock);
+
+    uint32 l_Count = m_RingCount.load(std::memory_order_relaxed);
+
+    t_LogRingGeneration = m_Generation;
+    t_LogRing = l_Count < MAX_RINGS ? new LogRingBuffer() : nullptr;
+
+    if (t_LogRing)
+    {
+        m_Rings[l_Count] = t_LogRing;
+        m_RingCount.store(l_Count + 1, std::memory_order_release);
+    }
+
+    return t_LogRing;
+}
+
+bool LogWorker::Write(Logger* p_Logger, uint8 p_Level, uint8 p_Type, char const* p_Format, va_list p_Args)
+{
+    LogRingBuffer* l_Ring = GetThreadRing();
+    if (!l_Ring)
+        return false;
+
+    uint32 l_Head = l_Ring->Head.load(std::memory_order_relaxed);
+    if (l_Head - l_Ring->Tail.load(std::memory_order_acquire) >= LogRingBuffer::SIZE)
+    {
+        /// Overloaded, the message is dropped rather than blocking the caller
+        ++l_Ring->Dropped;
+        return true;
+    }
+
+    LogRingEntry& l_Entry = l_Ring->Entries[l_Head & LogRingBuffer::MASK];
+
+    /// Keep room for the line feed appended to every message
+    int l_Length = vsnprintf(l_Entry.Text, LogRingEntry::TEXT_SIZE - 1, p_Format, p_Args);
+    if (l_Length < 0 || l_Length >= LogRingEntry::TEXT_SIZE - 1)
+        return false;
+
+    l_Entry.Text[l_Length] = '\n';
+    l_Entry.Text[l_Length + 1] = '\0';
+    l_Entry.Target = p_Logger;
+    l_Entry.Level = p_Level;
+    l_Entry.Type = p_Type;
+    l_Entry.Time = time(NULL);
+
+    l_Ring->Head.store(l_Head + 1, std::memory_order_release);
+    return true;
+}
+
+uint32 LogWorker::DrainRings()
+{
+    uint32 l_Written = 0;
+    uint32 l_Count = m_RingCount.load(std::memory_order_acquire);
+
+    for (uint32 l_I = 0; l_I < l_Count; ++l_I)
+    {
+        LogRingBuffer* l_Ring = m_Rings[l_I];
+
+        uint32 l_Tail = l_Ring->Tail.load(std::memory_order_relaxed);
+        uint32 l_Head = l_Ring->Head.load(std::memory_order_acquire);
+
+        for (; l_Tail != l_Head; ++l_Tail, ++l_Written)
+        {
+            LogRingEntry const& l_Entry = l_Ring->Entries[l_Tail & LogRingBuffer::MASK];
+
+            LogMessage l_Message(LogLevel(l_Entry.Level), LogFilterType(l_Entry.Type), l_Entry.Text);
+            l_Message.mtime = l_Entry.Time;
+
+            if (l_Entry.Target)
+                l_Entry.Target->write(l_Message);
+
+            /// Free the entry as soon as it is written so the producer can reuse it
+            l_Ring->Tail.store(l_Tail + 1, std::memory_order_release);
+        }
+
+        uint32 l_Dropped = l_Ring->Dropped.exchange(0);
+        if (l_Dropped && m_DropLogger)
+        {
+            char l_Text[128];
+            snprintf(l_Text, sizeof(l_Text), "LogWorker: %u messages dropped, the logging thread was writing faster than the appenders\n", l_Dropped);
+
+            LogMessage l_Message(LOG_LEVEL_ERROR, LOG_FILTER_GENERAL, l_Text);
+            m_DropLogger->write(l_Message);
+        }
+    }
+
+    return l_Written;
+}
+
 int LogWorker::svc()
 {
     while (1)
     {
+        /// Keep writing while the rings are busy, only wait on the queue once they are empty
+        ACE_Time_Value l_Timeout = ACE_Time_Value::zero;
+        if (!DrainRings())
+            l_Timeout = ACE_Time_Value(0, IDLE_WAIT * 1000);
+
+        ACE_Time_Value l_Deadline = ACE_OS::gettimeofday() + l_Timeout;
+
         LogOperation* request;
-        if (m_queue.dequeue(request) == -1)
+        if (m_queue.dequeue(request, &l_Deadline) == -1)
+        {
+            if (errno == EWOULDBLOCK)
+                continue;
+
+            /// Queue deactivated, write what is left before exiting
+            DrainRings();
             break;
+        }
 
         request->call();
         delete request;
@@ -9,10 +9,48 @@
 #ifndef LOGWORKER_H
 #define LOGWORKER_H
 
+#include "Define.h"
 #include "LogOperation.h"
 
 #include <ace/Task.h>
 #include <ace/Activation_Queue.h>
+#include <atomic>
+#include <cstdarg>
+#include <mutex>
+
+class Logger;
+
+/// Message formatted by the logging thread, written to the appenders by the log worker
+struct LogRingEntry
+{
+    enum
+    {
+        TEXT_SIZE = 512                                 ///< Longer messages go through the LogOperation queue
+    };
+
+    Logger* Target;
+    uint8 Level;                                        ///< LogLevel
+    uint8 Type;                                         ///< LogFilterType
+    time_t Time;
+    char Text[TEXT_SIZE];
+};
+
+/// Single producer (the logging thread) single consumer (the log worker) queue of formatted messages
+struct LogRingBuffer
+{
+    enum
+    {
+        SIZE = 1024,                                    ///< Power of two
+        MASK = SIZE - 1
+    };
+
+    LogRingBuffer() : Head(0), Tail(0), Dropped(0) { }
+
+    std::atomic<uint32> Head;                           ///< Next entry written by the producer
+    std::atomic<uint32> Tail;                           ///< Next entry read by the worker
+    std::atomic<uint32> Dropped;                        ///< Messages lost because the ring was full
+    LogRingEntry Entries[SIZE];
+};
 
 class LogWorker: protected ACE_Task_Base
 {
@@ -25,14 +63,34 @@ class LogWorker: protected ACE_Task_Base
         enum
         {
             HIGH_WATERMARK = 8 * 1024 * 1024,
-            LOW_WATERMARK  = 8 * 1024 * 1024
+            LOW_WATERMARK  = 8 * 1024 * 1024,
+            MAX_RINGS      = 64,                        ///< Threads beyond this count use the LogOperation queue
+            IDLE_WAIT      = 5                          ///< Milliseconds waited on the queue when every ring is empty
         };
 
         int enqueue(LogOperation *op);
 
+        /// Format the message in the ring of the calling thread without any allocation or lock
+        /// Returns false if the message can't use a ring (too long, too many threads), p_Args is consumed anyway
+        bool Write(Logger* p_Logger, uint8 p_Level, uint8 p_Type, char const* p_Format, va_list p_Args);
+
+        /// Logger receiving the reports of dropped messages
+        void SetDropLogger(Logger* p_Logger) { m_DropLogger = p_Logger; }
+
     private:
         virtual int svc();
+
+        LogRingBuffer* GetThreadRing();
+        /// Write every pending ring entry, returns the number of messages written
+        uint32 DrainRings();
+
         LogMessageQueueType m_queue;
+
+        std::mutex m_RingsLock;                         ///< Only taken when a thread logs for the first time
+        LogRingBuffer* m_Rings[MAX_RINGS];
+        std::atomic<uint32> m_RingCount;
+        uint32 m_Generation;                            ///< Invalidates the thread ring pointers of a previous worker
+        Logger* m_DropLogger;
 };
 
 #endif
@@ -8,95 +8,353 @@
 
 #include "EventProcessor.h"
 
+#if defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+/// Blocks are rounded up to a size class and recycled through per thread free lists,
+/// an event freed by another thread than the one which created it just joins the list of that thread
+enum EventPoolSettings
+{
+    EVENT_POOL_GRANULARITY = 16,
+    EVENT_POOL_CLASSES     = 16,                            ///< Events up to 256 bytes are pooled
+    EVENT_POOL_MAX_FREE    = 1024                           ///< Free blocks kept per thread and size class
+};
+
+static thread_local void* s_EventFreeLists[EVENT_POOL_CLASSES];
+static thread_local uint32 s_EventFreeCounts[EVENT_POOL_CLASSES];
+
+void* BasicEvent::operator new(size_t p_Size)
+{
+    uint32 l_Class = uint32((p_Size - 1) / EVENT_POOL_GRANULARITY);
+    if (l_Class >= EVENT_POOL_CLASSES)
+        return ::operator new(p_Size);
+
+    if (void* l_Block = s_EventFreeLists[l_Class])
+    {
+        s_EventFreeLists[l_Class] = *reinterpret_cast<void**>(l_Block);
+        --s_EventFreeCounts[l_Class];
+        return l_Block;
+    }
+
+    return ::operator new((l_Class + 1) * EVENT_POOL_GRANULARITY);
+}
+
+void BasicEvent::operator delete(void* p_Pointer, size_t p_Size)
+{
+    uint32 l_Class = uint32((p_Size - 1) / EVENT_POOL_GRANULARITY);
+    if (l_Class >= EVENT_POOL_CLASSES || s_EventFreeCounts[l_Class] >= EVENT_POOL_MAX_FREE)
+    {
+        ::operator delete(p_Pointer);
+        return;
+    }
+
+    *reinterpret_cast<void**>(p_Pointer) = s_EventFreeLists[l_Class];
+    s_EventFreeLists[l_Class] = p_Pointer;
+    ++s_EventFreeCounts[l_Class];
+}
+
+static uint32 CountTrailingZeros(uint64 p_Word)
+{
+#if defined(_MSC_VER)
+    unsigned long l_Index;
+    _BitScanForward64(&l_Index, p_Word);
+    return l_Index;
+#else
+    return __builtin_ctzll(p_Word);
+#endif
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_WheelTick = 0;
+    m_NextSequence = 0;
+    memset(m_Occupied, 0, sizeof(m_Occupied));
+    memset(m_Slots, 0, sizeof(m_Slots));
+    m_UpperWheel = nullptr;
+    m_HasOverflow = false;
     m_aborting = false;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    delete m_UpperWheel;
 }
 
 void EventProcessor::Update(uint32 p_time)
 {
-    auto d = [this](BasicEvent* Event) {
-        Event->Abort(m_time);
-        delete Event;
-    };
-    auto c = [this](BasicEvent* Event, uint32 p_time) {
-        if (Event->Execute(m_time, p_time))
+    // update time
+    m_time += p_time;
+
+    uint64 l_TargetTick = m_time >> EVENT_WHEEL_RESOLUTION_BITS;
+
+    uint32 l_Pending = m_HasOverflow;
+    for (uint32 l_Level = 0; l_Level < EVENT_WHEEL_LEVELS; ++l_Level)
+        l_Pending |= m_Occupied[l_Level];
+
+    if (!l_Pending)
+    {
+        m_WheelTick = l_TargetTick;
+        return;
+    }
+
+    for (;;)
+    {
+        uint32 l_Slot = uint32(m_WheelTick & (EVENT_WHEEL_SLOTS - 1));
+        if (m_Occupied[0] & (1 << l_Slot))
+            RunSlot(l_Slot, p_time);
+
+        if (m_WheelTick >= l_TargetTick)
+            break;
+
+        /// Jump to the next occupied slot of this turn of the wheel, or to the start of the next turn
+        uint64 l_TurnStart = m_WheelTick - l_Slot;
+        uint32 l_Later = m_Occupied[0] & ~((2 << l_Slot) - 1);
+        uint64 l_NextTick = l_Later ? l_TurnStart + CountTrailingZeros(l_Later) : l_TurnStart + EVENT_WHEEL_SLOTS;
+
+        m_WheelTick = std::min(l_NextTick, l_TargetTick);
+
+        if (!(m_WheelTick & (EVENT_WHEEL_SLOTS - 1)))
+            Cascade(m_WheelTick);
+    }
+}
+
+void EventProcessor::KillAllEvents(bool force)
+{
+    // prevent event insertions
+    m_aborting = true;
+
+    // non deletable events stay in their slot, they get deleted when reached
+    for (uint32 l_Level = 0; l_Level < EVENT_WHEEL_LEVELS; ++l_Level)
+    {
+        for (uint32 l_Slot = 0; l_Slot < EVENT_WHEEL_SLOTS; ++l_Slot)
         {
-            // completely destroy event if it is not re-added
-            delete Event;
+            if (m_Occupied[l_Level] & (1 << l_Slot))
+                AbortList(GetSlot(l_Level, l_Slot), force, !l_Level);
         }
-    };
-    auto b = [this, &c, &d](EventList::iterator i, uint32 p_time) {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+    }
 
-        if (!Event->to_Abort)
+    if (m_HasOverflow)
+        AbortList(m_UpperWheel->Overflow, force, false);
+
+    for (uint32 l_Level = 0; l_Level < EVENT_WHEEL_LEVELS; ++l_Level)
+    {
+        m_Occupied[l_Level] = 0;
+        if (l_Level && !m_UpperWheel)
+            continue;
+
+        for (uint32 l_Slot = 0; l_Slot < EVENT_WHEEL_SLOTS; ++l_Slot)
         {
-            c(Event, p_time);
+            if (GetSlot(l_Level, l_Slot))
+                m_Occupied[l_Level] |= 1 << l_Slot;
         }
+    }
+
+    m_HasOverflow = m_UpperWheel && m_UpperWheel->Overflow;
+}
+
+void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
+{
+    if (set_addtime) Event->m_addTime = m_time;
+    Event->m_execTime = e_time;
+    Event->m_Sequence = m_NextSequence++;
+
+    Schedule(Event);
+}
+
+uint64 EventProcessor::CalculateTime(uint64 t_offset) const
+{
+    return(m_time + t_offset);
+}
+
+BasicEvent*& EventProcessor::GetSlot(uint32 p_Level, uint32 p_Slot)
+{
+    if (!p_Level)
+        return m_Slots[p_Slot];
+
+    if (!m_UpperWheel)
+        m_UpperWheel = new UpperWheel();
+
+    return m_UpperWheel->Slots[p_Level - 1][p_Slot];
+}
+
+void EventProcessor::Schedule(BasicEvent* p_Event)
+{
+    /// Events already late go to the slot being run
+    uint64 l_Tick  = std::max(p_Event->m_execTime >> EVENT_WHEEL_RESOLUTION_BITS, m_WheelTick);
+    uint64 l_Delta = l_Tick - m_WheelTick;
+
+    for (uint32 l_Level = 0; l_Level < EVENT_WHEEL_LEVELS; ++l_Level)
+    {
+        if (l_Delta >> (EVENT_WHEEL_SLOT_BITS * (l_Level + 1)))
+            continue;
+
+        uint32 l_Slot = uint32(l_Tick >> (EVENT_WHEEL_SLOT_BITS * l_Level)) & (EVENT_WHEEL_SLOTS - 1);
+
+        /// Only level 0 is run, upper levels are sorted when cascading down
+        if (!l_Level)
+            InsertSorted(m_Slots[l_Slot], p_Event);
         else
+            Push(GetSlot(l_Level, l_Slot), p_Event);
+
+        m_Occupied[l_Level] |= 1 << l_Slot;
+        return;
+    }
+
+    if (!m_UpperWheel)
+        m_UpperWheel = new UpperWheel();
+
+    Push(m_UpperWheel->Overflow, p_Event);
+    m_HasOverflow = true;
+}
+
+void EventProcessor::Cascade(uint64 p_Tick)
+{
+    /// Called at the start of each turn of level 0, a slot of the upper level is spread down every time a level wraps
+    for (uint32 l_Level = 1; l_Level <= EVENT_WHEEL_LEVELS; ++l_Level)
+    {
+        BasicEvent* l_Event = nullptr;
+        uint32 l_Slot = 0;
+
+        if (l_Level < EVENT_WHEEL_LEVELS)
         {
-            d(Event);
+            l_Slot = uint32(p_Tick >> (EVENT_WHEEL_SLOT_BITS * l_Level)) & (EVENT_WHEEL_SLOTS - 1);
+            if (m_Occupied[l_Level] & (1 << l_Slot))
+            {
+                m_Occupied[l_Level] &= ~(1 << l_Slot);
+                std::swap(l_Event, GetSlot(l_Level, l_Slot));
+            }
         }
-    };
-    auto a = [this, &b](uint32 p_time) {
-        // main event loop
-        EventList::iterator i;
-        while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+        else if (m_HasOverflow)
         {
-            b(i, p_time);
+            m_HasOverflow = false;
+            std::swap(l_Event, m_UpperWheel->Overflow);
         }
-    };
 
-    // update time
-    m_time += p_time;
+        while (l_Event)
+        {
+            BasicEvent* l_Next = l_Event->m_NextEvent;
+            Schedule(l_Event);
+            l_Event = l_Next;
+        }
 
-    a(p_time);
+        if (l_Slot)
+            break;
+    }
 }
 
-void EventProcessor::KillAllEvents(bool force)
+void EventProcessor::RunSlot(uint32 p_Slot, uint32 p_Diff)
 {
-    // prevent event insertions
-    m_aborting = true;
+    BasicEvent*& l_List = m_Slots[p_Slot];
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    // main event loop, events added to this slot while running are run too if they are due
+    while (l_List && l_List->m_NextEvent->m_execTime <= m_time)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        // get and remove event from queue
+        BasicEvent* l_Event = PopFront(l_List);
+        if (!l_List)
+            m_Occupied[0] &= ~(1 << p_Slot);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        if (!l_Event->to_Abort)
         {
-            delete i_old->second;
-
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            // completely destroy event if it is not re-added
+            if (l_Event->Execute(m_time, p_Diff))
+                delete l_Event;
+        }
+        else
+        {
+            l_Event->Abort(m_time);
+            delete l_Event;
         }
     }
+}
+
+void EventProcessor::AbortList(BasicEvent*& p_List, bool p_Force, bool p_Sorted)
+{
+    BasicEvent* l_Event = nullptr;
+    if (p_Sorted)
+        l_Event = Detach(p_List);
+    else
+        std::swap(l_Event, p_List);
+
+    while (l_Event)
+    {
+        BasicEvent* l_Next = l_Event->m_NextEvent;
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+        l_Event->to_Abort = true;
+        l_Event->Abort(m_time);
+
+        if (p_Force || l_Event->IsDeletable())
+            delete l_Event;
+        else if (p_Sorted)
+            InsertSorted(p_List, l_Event);
+        else
+            Push(p_List, l_Event);
+
+        l_Event = l_Next;
+    }
 }
 
-void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
+void EventProcessor::InsertSorted(BasicEvent*& p_List, BasicEvent* p_Event)
 {
-    if (set_addtime) Event->m_addTime = m_time;
-    Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    auto l_Before = [](BasicEvent const* p_A, BasicEvent const* p_B) -> bool
+    {
+        return p_A->m_execTime < p_B->m_execTime || (p_A->m_execTime == p_B->m_execTime && p_A->m_Sequence < p_B->m_Sequence);
+    };
+
+    if (!p_List)
+    {
+        p_Event->m_NextEvent = p_Event;
+        p_List = p_Event;
+        return;
+    }
+
+    /// Most events go last, otherwise walk from the first one
+    if (!l_Before(p_Event, p_List))
+    {
+        p_Event->m_NextEvent = p_List->m_NextEvent;
+        p_List->m_NextEvent = p_Event;
+        p_List = p_Event;
+        return;
+    }
+
+    BasicEvent* l_Previous = p_List;
+    while (!l_Before(p_Event, l_Previous->m_NextEvent))
+        l_Previous = l_Previous->m_NextEvent;
+
+    p_Event->m_NextEvent = l_Previous->m_NextEvent;
+    l_Previous->m_NextEvent = p_Event;
 }
 
-uint64 EventProcessor::CalculateTime(uint64 t_offset) const
+void EventProcessor::Push(BasicEvent*& p_List, BasicEvent* p_Event)
 {
-    return(m_time + t_offset);
+    p_Event->m_NextEvent = p_List;
+    p_List = p_Event;
+}
+
+BasicEvent* EventProcessor::PopFront(BasicEvent*& p_List)
+{
+    BasicEvent* l_First = p_List->m_NextEvent;
+
+    if (l_First == p_List)
+        p_List = nullptr;
+    else
+        p_List->m_NextEvent = l_First->m_NextEvent;
+
+    return l_First;
 }
 
+BasicEvent* EventProcessor::Detach(BasicEvent*& p_List)
+{
+    if (!p_List)
+        return nullptr;
+
+    /// Open the circle, the chain ends on a null pointer
+    BasicEvent* l_First = p_List->m_NextEvent;
+    p_List->m_NextEvent = nullptr;
+    p_List = nullptr;
+
+    return l_First;
+}
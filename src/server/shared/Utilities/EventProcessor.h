@@ -16,10 +16,15 @@
 
 class BasicEvent
 {
+    friend class EventProcessor;
+
     public:
         BasicEvent() { to_Abort = false; }
         virtual ~BasicEvent() {}                              // override destructor to perform some actions on event removal
 
+        /// Events come from a per thread pool of fixed size blocks, see EventProcessor.cpp
+        static void* operator new(size_t p_Size);
+        static void operator delete(void* p_Pointer, size_t p_Size);
 
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
@@ -36,10 +41,22 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+
+    private:
+        BasicEvent* m_NextEvent;                            ///< Next event of the same wheel slot
+        uint64 m_Sequence;                                  ///< Insertion order, breaks ties between events of the same time
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+enum EventWheel
+{
+    EVENT_WHEEL_RESOLUTION_BITS = 8,                        ///< A tick of the wheel is 256 ms, events of a tick still run in time order
+    EVENT_WHEEL_SLOT_BITS       = 4,
+    EVENT_WHEEL_SLOTS           = 1 << EVENT_WHEEL_SLOT_BITS,
+    EVENT_WHEEL_LEVELS          = 4                         ///< 4 s, 65 s, 17 min and 4.6 h ranges, later events wait in an overflow list
+};
 
+/// Hierarchical timer wheel, events are linked in place so adding and expiring them costs no allocation
+/// Events of a level 0 slot are sorted by time then insertion order, so they run in the same order as a time sorted queue
 class EventProcessor
 {
     public:
@@ -51,8 +68,34 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
     protected:
+        /// Levels above 0, allocated with the first event scheduled there
+        struct UpperWheel
+        {
+            BasicEvent* Slots[EVENT_WHEEL_LEVELS - 1][EVENT_WHEEL_SLOTS];
+            BasicEvent* Overflow;
+        };
+
+        BasicEvent*& GetSlot(uint32 p_Level, uint32 p_Slot);
+        void Schedule(BasicEvent* p_Event);
+        void Cascade(uint64 p_Tick);
+        void RunSlot(uint32 p_Slot, uint32 p_Diff);
+        void AbortList(BasicEvent*& p_List, bool p_Force, bool p_Sorted);
+
+        /// Level 0 lists are circular, sorted and referenced by their last event
+        static void InsertSorted(BasicEvent*& p_List, BasicEvent* p_Event);
+        static BasicEvent* PopFront(BasicEvent*& p_List);
+        static BasicEvent* Detach(BasicEvent*& p_List);
+
+        /// Upper level lists are unordered stacks, the event order only matters once back in level 0
+        static void Push(BasicEvent*& p_List, BasicEvent* p_Event);
+
         uint64 m_time;
-        EventList m_events;
+        uint64 m_WheelTick;                                 ///< Tick of the level 0 slot being run, earlier ticks are done
+        uint64 m_NextSequence;
+        uint32 m_Occupied[EVENT_WHEEL_LEVELS];              ///< One bit per non empty slot, empty slots are never read
+        BasicEvent* m_Slots[EVENT_WHEEL_SLOTS];             ///< Level 0, next to the bits so a tick costs no extra cache miss
+        UpperWheel* m_UpperWheel;
+        bool m_HasOverflow;
         bool m_aborting;
 };
 #endif
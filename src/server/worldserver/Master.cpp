@@ -750,6 +750,8 @@ bool Master::_StartDB()
         return false;
     }
 
+    CharacterDatabase.SetBackPressureDepth(ConfigMgr::GetIntDefault("CharacterDatabase.BackPressureDepth", 5000));
+
     //////////////////////////////////////////////////////////////////////////
     //////////////////////////////////////////////////////////////////////////
 